@@ -0,0 +1,355 @@
+/*
+ * Benchmark of the Skinny variants, kernels, batch sizes and thread counts
+ * Date: Oct 17, 2026
+*/
+// Usage: bench.o [--quick] [--reps N] [--warmup N]
+// Key schedule, encryption and decryption of Skinny-64-128, 64-192, 128-256 and 128-384
+// with the reference enc()/dec(), the unrolled encrypt()/decrypt() and encrypt_otf()/
+// decrypt_otf() (on-the-fly tweakey schedule) and the batch kernels of every ISA the CPU
+// supports, over a sweep of batch sizes; the batch kernels also run on 1, 2, 4, ... threads
+// and on one thread per core, for every batch of two chunks or more (--quick: 1, 2 and one
+// per core, on one such batch).
+// Multi-key batches (a tweakey per block) compare expand_key() and encrypt() per block with
+// encrypt_multikey(). Every measurement is repeated: after the warm-up runs, each
+// repetition times enough calls to last about a millisecond, and the median, 10th and 90th
+// percentiles of the repetitions are reported. The results go to stdout as JSON, a table
+// goes to stderr. Cycles come from the time-stamp counter on x86 (the nominal frequency,
+// not the core clock under turbo) and are wall-clock time on several threads; elsewhere
+// they are nanoseconds.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "skinny_dispatch.h"
+#include "work_pool.h"
+
+using namespace std;
+using namespace skinny;
+
+struct Options
+{
+    int reps = 11;
+    int warmup = 3;
+    bool quick = false;
+};
+
+struct Percentiles
+{
+    double p10, median, p90;
+};
+
+struct Measurement
+{
+    Percentiles ticks; // per call
+    Percentiles ns;    // per call
+};
+
+struct Record
+{
+    string cipher, kernel, op;
+    size_t batch;
+    unsigned threads;
+    size_t bytes; // per call, 0 for the key schedule
+    Measurement m;
+};
+
+// Blocks per task when a batch is split over threads, as in Ctr
+static const size_t CHUNK_BLOCKS = 2048;
+// From 8192 on, a batch is split into several chunks and runs on every pool
+static const size_t BATCHES[] = {1, 16, 64, 512, 2048, 8192, 32768, 262144};
+static const size_t QUICK_BATCHES[] = {1, 512, 8192};
+
+static volatile uint8_t sink;
+
+static inline uint64_t ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static Percentiles percentiles(vector<double> samples)
+{
+    sort(samples.begin(), samples.end());
+    size_t n = samples.size() - 1;
+    return Percentiles{samples[n / 10], samples[n / 2], samples[(9 * n + 5) / 10]};
+}
+
+// Times fn() after the warm-up; the number of calls per repetition is doubled until a
+// repetition lasts at least a millisecond
+static Measurement measure(const Options &opt, const function<void()> &fn)
+{
+    typedef chrono::steady_clock clock;
+    for (int w = 0; w < opt.warmup; w++)
+        fn();
+    size_t calls = 1;
+    for (;;)
+    {
+        clock::time_point start = clock::now();
+        for (size_t i = 0; i < calls; i++)
+            fn();
+        if (clock::now() - start >= chrono::milliseconds(1) || calls >= (1u << 20))
+            break;
+        calls *= 2;
+    }
+    vector<double> tick_samples, ns_samples;
+    for (int r = 0; r < opt.reps; r++)
+    {
+        clock::time_point start = clock::now();
+        uint64_t t0 = ticks();
+        for (size_t i = 0; i < calls; i++)
+            fn();
+        uint64_t t1 = ticks();
+        double ns = static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(clock::now() - start).count());
+        tick_samples.push_back(static_cast<double>(t1 - t0) / calls);
+        ns_samples.push_back(ns / calls);
+    }
+    return Measurement{percentiles(tick_samples), percentiles(ns_samples)};
+}
+
+static void report(vector<Record> &records, const Record &r)
+{
+    records.push_back(r);
+    if (r.bytes == 0)
+        fprintf(stderr, "%-16s %-10s %-16s %6s %3s %12.1f cycles\n", r.cipher.c_str(), r.kernel.c_str(), r.op.c_str(), "-", "-",
+                r.m.ticks.median);
+    else
+        fprintf(stderr, "%-16s %-10s %-16s %6zu %3u %12.2f cycles/byte %14.0f blocks/s\n", r.cipher.c_str(), r.kernel.c_str(),
+                r.op.c_str(), r.batch, r.threads, r.m.ticks.median / r.bytes, r.batch * 1e9 / r.m.ns.median);
+}
+
+template <class Cipher>
+void bench_cipher(const char *name, const Options &opt, const vector<WorkStealingPool *> &pools, vector<Record> &records)
+{
+    const int R = Cipher::ROUNDS;
+    const size_t block_bytes = Cipher::BLOCK_BITS / 8;
+    const vector<size_t> batches = opt.quick ? vector<size_t>(begin(QUICK_BATCHES), end(QUICK_BATCHES))
+                                             : vector<size_t>(begin(BATCHES), end(BATCHES));
+    const size_t most = *max_element(batches.begin(), batches.end());
+    uint8_t tk[3][16], rtk[R][8];
+    typename Cipher::Key key;
+    typename Cipher::TweakeyState first, last;
+    unique_ptr<uint8_t[][16]> in(new uint8_t[most][16]), out(new uint8_t[most][16]);
+    srand(1);
+    for (int l = 0; l < 3; l++)
+        for (int i = 0; i < 16; i++)
+            tk[l][i] = static_cast<uint8_t>(rand() & Cipher::CELL_MASK);
+    for (size_t j = 0; j < most; j++)
+        for (int i = 0; i < 16; i++)
+            in[j][i] = static_cast<uint8_t>(rand() & Cipher::CELL_MASK);
+    Cipher::tweakey_schedule(R, tk, rtk);
+    Cipher::expand_key(tk, key);
+    Cipher::load_tweakey(tk, first);
+    Cipher::load_tweakey(tk, last, R - 1);
+
+    // Reference and unrolled code, one block after the other
+    report(records, Record{name, "reference", "key_schedule", 1, 1, 0, measure(opt, [&] {
+                               Cipher::tweakey_schedule(R, tk, rtk);
+                               sink = rtk[R - 1][0];
+                           })});
+    report(records, Record{name, "unrolled", "key_schedule", 1, 1, 0, measure(opt, [&] {
+                               Cipher::expand_key(tk, key);
+                               sink = static_cast<uint8_t>(key.rtk[R - 1][0]);
+                           })});
+    report(records, Record{name, "on-the-fly", "key_schedule", 1, 1, 0, measure(opt, [&] {
+                               Cipher::load_tweakey(tk, last, R - 1);
+                               sink = static_cast<uint8_t>(last.t[0][0]);
+                           })});
+    for (size_t batch : batches)
+    {
+        if (batch > CHUNK_BLOCKS)
+            continue;
+        size_t bytes = batch * block_bytes;
+        report(records, Record{name, "reference", "encrypt", batch, 1, bytes, measure(opt, [&] {
+                                   for (size_t j = 0; j < batch; j++)
+                                       Cipher::enc(R, in[j], out[j], rtk);
+                                   sink = out[batch - 1][0];
+                               })});
+        report(records, Record{name, "reference", "decrypt", batch, 1, bytes, measure(opt, [&] {
+                                   for (size_t j = 0; j < batch; j++)
+                                       Cipher::dec(R, out[j], in[j], rtk);
+                                   sink = out[batch - 1][0];
+                               })});
+        report(records, Record{name, "unrolled", "encrypt", batch, 1, bytes, measure(opt, [&] {
+                                   for (size_t j = 0; j < batch; j++)
+                                       Cipher::encrypt(key, in[j], out[j]);
+                                   sink = out[batch - 1][0];
+                               })});
+        report(records, Record{name, "unrolled", "decrypt", batch, 1, bytes, measure(opt, [&] {
+                                   for (size_t j = 0; j < batch; j++)
+                                       Cipher::decrypt(key, out[j], in[j]);
+                                   sink = out[batch - 1][0];
+                               })});
+        report(records, Record{name, "on-the-fly", "encrypt", batch, 1, bytes, measure(opt, [&] {
+                                   for (size_t j = 0; j < batch; j++)
+                                       Cipher::encrypt_otf(first, in[j], out[j]);
+                                   sink = out[batch - 1][0];
+                               })});
+        report(records, Record{name, "on-the-fly", "decrypt", batch, 1, bytes, measure(opt, [&] {
+                                   for (size_t j = 0; j < batch; j++)
+                                       Cipher::decrypt_otf(last, out[j], in[j]);
+                                   sink = out[batch - 1][0];
+                               })});
+    }
+
+    // Batch kernels of every supported ISA, on one thread and then split into chunks on the pools
+    for (int isa = 0; isa < ISA_COUNT; isa++)
+    {
+        const Kernels *k = kernels_for<Cipher>(isa);
+        if (k == NULL || !cpu_supports(isa))
+            continue;
+        report(records, Record{name, k->name, "key_schedule", 1, 1, 0, measure(opt, [&] {
+                                   k->tweakey_schedule(tk, rtk);
+                                   sink = rtk[R - 1][0];
+                               })});
+        for (size_t batch : batches)
+        {
+            size_t bytes = batch * block_bytes;
+            for (WorkStealingPool *pool : pools)
+            {
+                if (pool->threads() > 1 && batch < 2 * CHUNK_BLOCKS)
+                    continue;
+                size_t tasks = (batch + CHUNK_BLOCKS - 1) / CHUNK_BLOCKS;
+                auto run = [&](bool encrypt) {
+                    auto chunk = [&](size_t c) {
+                        size_t first = c * CHUNK_BLOCKS, n = min(CHUNK_BLOCKS, batch - first);
+                        if (encrypt)
+                            k->encrypt(in.get() + first, out.get() + first, n, rtk);
+                        else
+                            k->decrypt(out.get() + first, in.get() + first, n, rtk);
+                    };
+                    if (pool->threads() > 1)
+                        pool->run(tasks, chunk);
+                    else
+                        for (size_t c = 0; c < tasks; c++)
+                            chunk(c);
+                    sink = out[batch - 1][0];
+                };
+                report(records, Record{name, k->name, "encrypt", batch, pool->threads(), bytes, measure(opt, [&] { run(true); })});
+                report(records, Record{name, k->name, "decrypt", batch, pool->threads(), bytes, measure(opt, [&] { run(false); })});
+            }
+        }
+    }
+
+    // Every block under its own tweakey: expand_key() and encrypt() per block, then the
+    // multi-key kernels that run the tweakey schedules bitsliced with the blocks
+    unique_ptr<uint8_t[][Cipher::LANES][16]> keys(new uint8_t[most][Cipher::LANES][16]);
+    for (size_t j = 0; j < most; j++)
+        for (int l = 0; l < Cipher::LANES; l++)
+            for (int i = 0; i < 16; i++)
+                keys[j][l][i] = static_cast<uint8_t>(rand() & Cipher::CELL_MASK);
+    for (size_t batch : batches)
+    {
+        if (batch > CHUNK_BLOCKS)
+            continue;
+        size_t bytes = batch * block_bytes;
+        report(records, Record{name, "unrolled", "encrypt_multikey", batch, 1, bytes, measure(opt, [&] {
+                                   for (size_t j = 0; j < batch; j++)
+                                   {
+                                       Cipher::expand_key(keys[j], key);
+                                       Cipher::encrypt(key, in[j], out[j]);
+                                   }
+                                   sink = out[batch - 1][0];
+                               })});
+        report(records, Record{name, "multi-key", "encrypt_multikey", batch, 1, bytes, measure(opt, [&] {
+                                   encrypt_multikey<Cipher>(R, in.get(), out.get(), batch, keys.get());
+                                   sink = out[batch - 1][0];
+                               })});
+        report(records, Record{name, "multi-key", "decrypt_multikey", batch, 1, bytes, measure(opt, [&] {
+                                   decrypt_multikey<Cipher>(R, out.get(), in.get(), batch, keys.get());
+                                   sink = out[batch - 1][0];
+                               })});
+    }
+}
+
+static void print_percentiles(const char *field, const Percentiles &p, double scale)
+{
+    printf("\"%s\": {\"p10\": %.3f, \"median\": %.3f, \"p90\": %.3f}", field, p.p10 * scale, p.median * scale, p.p90 * scale);
+}
+
+static void print_json(const Options &opt, const vector<Record> &records)
+{
+    const char *best = "scalar";
+    for (int isa = 0; isa < ISA_COUNT; isa++)
+        if (cpu_supports(isa))
+            best = isa_name(isa);
+#if defined(__x86_64__) || defined(__i386__)
+    const char *timer = "rdtsc";
+#else
+    const char *timer = "ns";
+#endif
+    printf("{\n  \"cpu_isa\": \"%s\",\n  \"timer\": \"%s\",\n  \"hardware_threads\": %u,\n  \"reps\": %d,\n  \"warmup\": %d,\n",
+           best, timer, thread::hardware_concurrency(), opt.reps, opt.warmup);
+    printf("  \"results\": [\n");
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const Record &r = records[i];
+        printf("    {\"cipher\": \"%s\", \"kernel\": \"%s\", \"op\": \"%s\", \"batch\": %zu, \"threads\": %u, \"bytes\": %zu, ",
+               r.cipher.c_str(), r.kernel.c_str(), r.op.c_str(), r.batch, r.threads, r.bytes);
+        print_percentiles("cycles_per_call", r.m.ticks, 1.0);
+        if (r.bytes != 0)
+        {
+            printf(", ");
+            print_percentiles("cycles_per_byte", r.m.ticks, 1.0 / r.bytes);
+            printf(", \"blocks_per_second\": %.0f", r.batch * 1e9 / r.m.ns.median);
+        }
+        else
+            printf(", \"calls_per_second\": %.0f", 1e9 / r.m.ns.median);
+        printf("}%s\n", (i + 1 < records.size()) ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+int main(int argc, char *argv[])
+{
+    Options opt;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+            opt.quick = true;
+        else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc)
+            opt.reps = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+            opt.warmup = max(0, atoi(argv[++i]));
+        else
+        {
+            fprintf(stderr, "usage: %s [--quick] [--reps N] [--warmup N]\n", argv[0]);
+            return 1;
+        }
+    }
+    // 1, 2, 4, ... threads up to the number of cores (and at least 2 to exercise the pool),
+    // then the number of cores itself if it is not a power of two
+    unsigned cores = max(2u, thread::hardware_concurrency());
+    vector<unsigned> counts;
+    for (unsigned t = 1; t <= cores && !(opt.quick && t > 2); t *= 2)
+        counts.push_back(t);
+    if (counts.back() != cores)
+        counts.push_back(cores);
+    vector<unique_ptr<WorkStealingPool>> owned;
+    vector<WorkStealingPool *> pools;
+    for (unsigned t : counts)
+    {
+        owned.emplace_back(new WorkStealingPool(t));
+        pools.push_back(owned.back().get());
+    }
+    vector<Record> records;
+    bench_cipher<Skinny64_128>("skinny-64-128", opt, pools, records);
+    bench_cipher<Skinny64_192>("skinny-64-192", opt, pools, records);
+    bench_cipher<Skinny128_256>("skinny-128-256", opt, pools, records);
+    bench_cipher<Skinny128_384>("skinny-128-384", opt, pools, records);
+    print_json(opt, records);
+    return 0;
+}
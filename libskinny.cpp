@@ -0,0 +1,226 @@
+/*
+ * libskinny: the C interface (skinny_c.h) over the header-only library
+ * Date: Oct 18, 2026
+*/
+// Built with -fvisibility=hidden, so only the skinny_* functions are exported. A key
+// holds the variant, its batch kernels, the round tweakeys in cells for those kernels and
+// the row-as-word expanded key for single blocks.
+
+#define SKINNY_BUILD_LIBRARY
+#include <new>
+#include <type_traits>
+#include "skinny_c.h"
+#include "skinny_dispatch.h"
+
+using namespace skinny;
+
+struct skinny_key
+{
+    skinny_variant variant;
+    const Kernels *kernels;
+    uint8_t rtk[Skinny128_384::ROUNDS][8];
+    union
+    {
+        Skinny64_128::Key k64_128;
+        Skinny64_192::Key k64_192;
+        Skinny128_256::Key k128_256;
+        Skinny128_384::Key k128_384;
+    };
+};
+
+namespace
+{
+
+// The expanded key of the variant in the union
+template <class Cipher>
+typename Cipher::Key &rows(skinny_key *key)
+{
+    if constexpr (std::is_same<Cipher, Skinny64_128>::value)
+        return key->k64_128;
+    else if constexpr (std::is_same<Cipher, Skinny64_192>::value)
+        return key->k64_192;
+    else if constexpr (std::is_same<Cipher, Skinny128_256>::value)
+        return key->k128_256;
+    else
+        return key->k128_384;
+}
+
+template <class Cipher>
+const typename Cipher::Key &rows(const skinny_key *key)
+{
+    return rows<Cipher>(const_cast<skinny_key *>(key));
+}
+
+// Calls f with a Cipher of the variant (only its type matters), SKINNY_ERROR_VARIANT otherwise
+template <class F>
+int with_cipher(skinny_variant variant, F &&f)
+{
+    switch (variant)
+    {
+    case SKINNY_64_128:
+        return f(Skinny64_128());
+    case SKINNY_64_192:
+        return f(Skinny64_192());
+    case SKINNY_128_256:
+        return f(Skinny128_256());
+    case SKINNY_128_384:
+        return f(Skinny128_384());
+    }
+    return SKINNY_ERROR_VARIANT;
+}
+
+} // namespace
+
+extern "C" {
+
+int skinny_abi_version(void)
+{
+    return SKINNY_ABI_VERSION;
+}
+
+const char *skinny_strerror(int error)
+{
+    switch (error)
+    {
+    case SKINNY_OK:
+        return "success";
+    case SKINNY_ERROR_VARIANT:
+        return "unknown Skinny variant";
+    case SKINNY_ERROR_ARGUMENT:
+        return "invalid argument";
+    case SKINNY_ERROR_MEMORY:
+        return "out of memory";
+    }
+    return "unknown error";
+}
+
+int skinny_kernel_info_get(skinny_variant variant, skinny_kernel_info *info)
+{
+    if (info == NULL)
+        return SKINNY_ERROR_ARGUMENT;
+    return with_cipher(variant, [&](auto cipher) {
+        typedef decltype(cipher) Cipher;
+        info->block_bits = Cipher::BLOCK_BITS;
+        info->tweakey_bits = Cipher::TWEAKEY_BITS;
+        info->rounds = Cipher::ROUNDS;
+        info->lanes = Cipher::LANES;
+        info->kernel = select_kernels<Cipher>().name;
+        return SKINNY_OK;
+    });
+}
+
+int skinny_key_create(skinny_variant variant, const uint8_t *tweakey, skinny_key **out)
+{
+    if (out == NULL)
+        return SKINNY_ERROR_ARGUMENT;
+    *out = NULL;
+    if (tweakey == NULL)
+        return SKINNY_ERROR_ARGUMENT;
+    if (with_cipher(variant, [](auto) { return SKINNY_OK; }) != SKINNY_OK)
+        return SKINNY_ERROR_VARIANT;
+    skinny_key *key = new (std::nothrow) skinny_key;
+    if (key == NULL)
+        return SKINNY_ERROR_MEMORY;
+    with_cipher(variant, [&](auto cipher) {
+        typedef decltype(cipher) Cipher;
+        const uint8_t(*tk)[16] = reinterpret_cast<const uint8_t(*)[16]>(tweakey);
+        key->variant = variant;
+        key->kernels = &select_kernels<Cipher>();
+        key->kernels->tweakey_schedule(tk, key->rtk);
+        Cipher::expand_key(tk, rows<Cipher>(key));
+        return SKINNY_OK;
+    });
+    *out = key;
+    return SKINNY_OK;
+}
+
+skinny_key *skinny_key_new(skinny_variant variant, const uint8_t *tweakey)
+{
+    skinny_key *key;
+    skinny_key_create(variant, tweakey, &key);
+    return key;
+}
+
+void skinny_key_free(skinny_key *key)
+{
+    delete key;
+}
+
+int skinny_key_variant(const skinny_key *key)
+{
+    if (key == NULL)
+        return SKINNY_ERROR_ARGUMENT;
+    return key->variant;
+}
+
+int skinny_encrypt_block(const skinny_key *key, const uint8_t *plaintext, uint8_t *ciphertext)
+{
+    if (key == NULL || plaintext == NULL || ciphertext == NULL)
+        return SKINNY_ERROR_ARGUMENT;
+    return with_cipher(key->variant, [&](auto cipher) {
+        typedef decltype(cipher) Cipher;
+        Cipher::encrypt(rows<Cipher>(key), plaintext, ciphertext);
+        return SKINNY_OK;
+    });
+}
+
+int skinny_decrypt_block(const skinny_key *key, uint8_t *plaintext, const uint8_t *ciphertext)
+{
+    if (key == NULL || plaintext == NULL || ciphertext == NULL)
+        return SKINNY_ERROR_ARGUMENT;
+    return with_cipher(key->variant, [&](auto cipher) {
+        typedef decltype(cipher) Cipher;
+        Cipher::decrypt(rows<Cipher>(key), plaintext, ciphertext);
+        return SKINNY_OK;
+    });
+}
+
+int skinny_encrypt(const skinny_key *key, const uint8_t *plaintext, uint8_t *ciphertext, size_t blocks)
+{
+    if (key == NULL || ((plaintext == NULL || ciphertext == NULL) && blocks > 0))
+        return SKINNY_ERROR_ARGUMENT;
+    if (blocks > 0)
+        key->kernels->encrypt(reinterpret_cast<const uint8_t(*)[16]>(plaintext), reinterpret_cast<uint8_t(*)[16]>(ciphertext),
+                              blocks, key->rtk);
+    return SKINNY_OK;
+}
+
+int skinny_decrypt(const skinny_key *key, uint8_t *plaintext, const uint8_t *ciphertext, size_t blocks)
+{
+    if (key == NULL || ((plaintext == NULL || ciphertext == NULL) && blocks > 0))
+        return SKINNY_ERROR_ARGUMENT;
+    if (blocks > 0)
+        key->kernels->decrypt(reinterpret_cast<uint8_t(*)[16]>(plaintext), reinterpret_cast<const uint8_t(*)[16]>(ciphertext),
+                              blocks, key->rtk);
+    return SKINNY_OK;
+}
+
+int skinny_encrypt_multikey(skinny_variant variant, const uint8_t *tweakeys, const uint8_t *plaintext, uint8_t *ciphertext,
+                            size_t blocks)
+{
+    if ((tweakeys == NULL || plaintext == NULL || ciphertext == NULL) && blocks > 0)
+        return SKINNY_ERROR_ARGUMENT;
+    return with_cipher(variant, [&](auto cipher) {
+        typedef decltype(cipher) Cipher;
+        encrypt_multikey<Cipher>(Cipher::ROUNDS, reinterpret_cast<const uint8_t(*)[16]>(plaintext),
+                                 reinterpret_cast<uint8_t(*)[16]>(ciphertext), blocks,
+                                 reinterpret_cast<const uint8_t(*)[Cipher::LANES][16]>(tweakeys));
+        return SKINNY_OK;
+    });
+}
+
+int skinny_decrypt_multikey(skinny_variant variant, const uint8_t *tweakeys, uint8_t *plaintext, const uint8_t *ciphertext,
+                            size_t blocks)
+{
+    if ((tweakeys == NULL || plaintext == NULL || ciphertext == NULL) && blocks > 0)
+        return SKINNY_ERROR_ARGUMENT;
+    return with_cipher(variant, [&](auto cipher) {
+        typedef decltype(cipher) Cipher;
+        decrypt_multikey<Cipher>(Cipher::ROUNDS, reinterpret_cast<uint8_t(*)[16]>(plaintext),
+                                 reinterpret_cast<const uint8_t(*)[16]>(ciphertext), blocks,
+                                 reinterpret_cast<const uint8_t(*)[Cipher::LANES][16]>(tweakeys));
+        return SKINNY_OK;
+    });
+}
+
+} // extern "C"
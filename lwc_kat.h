@@ -0,0 +1,86 @@
+/*
+ * Reader for the known-answer test files of the NIST lightweight cryptography submissions
+ * Date: Oct 18, 2026
+*/
+// The submission packages ship their vectors as LWC_AEAD_KAT_*.txt and LWC_HASH_KAT_*.txt:
+// records of "Name = hex" lines (Count, Key, Nonce, PT, AD, CT for AEAD; Count, Msg, MD
+// for hashes) separated by blank lines. read_record() returns the fields of the next record
+// with their values decoded, Count as its decimal digits. open_text() reads records pasted
+// into a program the same way.
+
+#ifndef LWC_KAT_H
+#define LWC_KAT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace skinny
+{
+
+namespace kat
+{
+
+typedef std::map<std::string, std::vector<uint8_t>> Record;
+
+// Reads up to the next blank line after at least one field; false at the end of the file
+inline bool read_record(FILE *f, Record &record)
+{
+    char line[4096];
+    record.clear();
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        std::string s(line);
+        size_t eq = s.find('=');
+        if (eq == std::string::npos)
+        {
+            if (!record.empty())
+                return true;
+            continue;
+        }
+        std::string name = s.substr(0, eq), value = s.substr(eq + 1);
+        while (!name.empty() && isspace(static_cast<unsigned char>(name.back())))
+            name.pop_back();
+        std::vector<uint8_t> bytes;
+        if (name == "Count")
+            bytes.assign(value.begin(), value.end());
+        else
+            for (size_t i = 0; i < value.size(); i++)
+                if (isxdigit(static_cast<unsigned char>(value[i])) && i + 1 < value.size() &&
+                    isxdigit(static_cast<unsigned char>(value[i + 1])))
+                {
+                    bytes.push_back(static_cast<uint8_t>(std::stoul(value.substr(i, 2), NULL, 16)));
+                    i++;
+                }
+        record[name] = bytes;
+    }
+    return !record.empty();
+}
+
+// Records embedded as text, as a stream for read_record(); NULL if the text is empty
+inline FILE *open_text(const char *text)
+{
+    size_t len = strlen(text);
+    return (len == 0) ? NULL : fmemopen(const_cast<char *>(text), len, "r");
+}
+
+// Count of a record for messages
+inline std::string count(const Record &record)
+{
+    auto it = record.find("Count");
+    if (it == record.end())
+        return "?";
+    std::string s(it->second.begin(), it->second.end());
+    size_t first = s.find_first_not_of(" \t"), last = s.find_last_not_of(" \t\r\n");
+    return (first == std::string::npos) ? "?" : s.substr(first, last - first + 1);
+}
+
+} // namespace kat
+
+} // namespace skinny
+
+#endif
@@ -0,0 +1,367 @@
+/*
+ * Romulus-N and Romulus-M on Skinny-128-384+
+ * Date: Oct 17, 2026
+*/
+//Skinny-128-384+: 40 rounds
+// Usage: romulus.o [-n|-m KAT_FILE]
+// Without arguments, checks the TBC, both modes against one-shot references written block
+// by block after the specification, round trips, forged tags and the streaming API, and
+// the records of the official vectors embedded below. With -n / -m, checks Romulus-N /
+// Romulus-M against LWC_AEAD_KAT_128_128.txt of the Romulus v1.3 submission package.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "lwc_kat.h"
+#include "romulus.h"
+
+using namespace std;
+using namespace skinny;
+
+typedef Skinny128_384_plus Cipher;
+
+void print_bytes(const uint8_t *bytes, size_t len);
+size_t split(const uint8_t *data, size_t len, vector<uint8_t> &blocks);
+void reference_tbc(const uint8_t key[16], const uint8_t cnt[7], uint8_t domain, const uint8_t tweak[16], uint8_t s[16]);
+void reference_n(const uint8_t key[16], const uint8_t nonce[16], const uint8_t *ad, size_t adlen, const uint8_t *m, size_t mlen, uint8_t *c);
+void reference_m(const uint8_t key[16], const uint8_t nonce[16], const uint8_t *ad, size_t adlen, const uint8_t *m, size_t mlen, uint8_t *c);
+int check_kat(bool romulus_m, FILE *f, const char *label);
+
+// Records of LWC_AEAD_KAT_128_128.txt from the Romulus v1.3 package, the Romulus-N and the
+// Romulus-M one, pasted verbatim: empty AD and PT, a partial PT block, AD and PT of
+// several blocks, and for Romulus-M an even number of AD blocks with an empty PT. Checked without arguments; the self-written references
+// above share any misreading of the specification, these do not. Empty: none embedded yet.
+static const char ROMULUS_N_KAT[] = "";
+static const char ROMULUS_M_KAT[] = "";
+
+void print_bytes(const uint8_t *bytes, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        printf("%02x", bytes[i]);
+    printf("\n");
+}
+
+// The blocks of the data, the last one padded; empty data is one empty block. Returns
+// their number.
+size_t split(const uint8_t *data, size_t len, vector<uint8_t> &blocks)
+{
+    size_t n = max<size_t>(1, (len + 15) / 16);
+    blocks.assign(16 * n, 0);
+    memcpy(blocks.data(), data, 16 * (n - 1));
+    romulus::pad(data + 16 * (n - 1), len - 16 * (n - 1), &blocks[16 * (n - 1)]);
+    return n;
+}
+
+// s = E(TK1 = cnt || domain, TK2 = tweak, TK3 = key)(s) with the plain tweakey schedule
+void reference_tbc(const uint8_t key[16], const uint8_t cnt[7], uint8_t domain, const uint8_t tweak[16], uint8_t s[16])
+{
+    const int R = Cipher::ROUNDS;
+    uint8_t tk[3][16], rtk[R][8], out[16];
+    romulus::Tbc::compose_tk1(cnt, domain, tk[0]);
+    memcpy(tk[1], tweak, 16);
+    memcpy(tk[2], key, 16);
+    Cipher::tweakey_schedule(R, tk, rtk);
+    Cipher::enc(R, s, out, rtk);
+    memcpy(s, out, 16);
+}
+
+// Romulus-N in one pass over whole blocks: pairs of associated-data blocks, the second one
+// as TK2, then one TBC call per message block
+void reference_n(const uint8_t key[16], const uint8_t nonce[16], const uint8_t *ad, size_t adlen, const uint8_t *m, size_t mlen, uint8_t *c)
+{
+    vector<uint8_t> A;
+    uint8_t s[16] = {0}, cnt[7];
+    size_t a = split(ad, adlen, A);
+    romulus::reset_counter(cnt);
+    for (size_t i = 0; i + 1 < a; i += 2)
+    {
+        romulus::absorb(s, &A[16 * i], 16);
+        romulus::clock_counter(cnt);
+        reference_tbc(key, cnt, 8, &A[16 * (i + 1)], s);
+        romulus::clock_counter(cnt);
+    }
+    if (a % 2 == 1)
+    {
+        romulus::absorb(s, &A[16 * (a - 1)], 16);
+        romulus::clock_counter(cnt);
+    }
+    reference_tbc(key, cnt, (adlen == 0 || adlen % 16 != 0) ? 26 : 24, nonce, s);
+    romulus::reset_counter(cnt);
+    size_t blocks = max<size_t>(1, (mlen + 15) / 16);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        size_t len = min<size_t>(16, mlen - 16 * i);
+        romulus::rho(s, m + 16 * i, c + 16 * i, len);
+        romulus::clock_counter(cnt);
+        reference_tbc(key, cnt, (i + 1 < blocks) ? 4 : (len < 16) ? 21 : 20, nonce, s);
+    }
+    romulus::tag_of(s, c + mlen);
+}
+
+// Romulus-M: the MAC over the blocks of A || M taken in pairs, the second block of each as
+// TK2 (domain 40 for an associated-data block, 44 for a message block), an odd last block
+// absorbed alone; then the tag as IV of the encryption, one TBC call per message block
+void reference_m(const uint8_t key[16], const uint8_t nonce[16], const uint8_t *ad, size_t adlen, const uint8_t *m, size_t mlen, uint8_t *c)
+{
+    vector<uint8_t> A, M;
+    uint8_t s[16] = {0}, cnt[7], tag[16];
+    size_t a = split(ad, adlen, A), b = split(m, mlen, M);
+    vector<uint8_t> Z(A);
+    Z.insert(Z.end(), M.begin(), M.end());
+    size_t z = a + b;
+    uint8_t w = 48;
+    if (adlen == 0 || adlen % 16 != 0)
+        w ^= 2;
+    if (mlen == 0 || mlen % 16 != 0)
+        w ^= 1;
+    if (a % 2 == 0)
+        w ^= 8;
+    if (b % 2 == 0)
+        w ^= 4;
+    romulus::reset_counter(cnt);
+    for (size_t i = 0; i + 1 < z; i += 2)
+    {
+        romulus::absorb(s, &Z[16 * i], 16);
+        romulus::clock_counter(cnt);
+        reference_tbc(key, cnt, (i + 1 < a) ? 40 : 44, &Z[16 * (i + 1)], s);
+        romulus::clock_counter(cnt);
+    }
+    if (z % 2 == 1)
+    {
+        romulus::absorb(s, &Z[16 * (z - 1)], 16);
+        romulus::clock_counter(cnt);
+    }
+    reference_tbc(key, cnt, w, nonce, s);
+    romulus::tag_of(s, tag);
+    memcpy(s, tag, 16);
+    romulus::reset_counter(cnt);
+    for (size_t i = 0; 16 * i < mlen; i++)
+    {
+        reference_tbc(key, cnt, 36, nonce, s);
+        romulus::rho(s, m + 16 * i, c + 16 * i, min<size_t>(16, mlen - 16 * i));
+        romulus::clock_counter(cnt);
+    }
+    memcpy(c + mlen, tag, 16);
+}
+
+// Every record of an LWC AEAD KAT file (closed here): encryption gives CT (ciphertext ||
+// tag), and decryption of CT gives PT back
+int check_kat(bool romulus_m, FILE *f, const char *label)
+{
+    kat::Record record;
+    size_t records = 0, mismatches = 0;
+    while (kat::read_record(f, record))
+    {
+        const vector<uint8_t> &key = record["Key"], &nonce = record["Nonce"], &pt = record["PT"], &ad = record["AD"],
+                              &ct = record["CT"];
+        records++;
+        if (key.size() != 16 || nonce.size() != 16 || ct.size() != pt.size() + 16)
+        {
+            printf("record %s: malformed\n", kat::count(record).c_str());
+            mismatches++;
+            continue;
+        }
+        vector<uint8_t> c(pt.size() + 16), m(pt.size() + 1);
+        if (romulus_m)
+            romulus_m_encrypt(key.data(), nonce.data(), ad.data(), ad.size(), pt.data(), pt.size(), c.data());
+        else
+            romulus_n_encrypt(key.data(), nonce.data(), ad.data(), ad.size(), pt.data(), pt.size(), c.data());
+        bool valid = romulus_m ? romulus_m_decrypt(key.data(), nonce.data(), ad.data(), ad.size(), ct.data(), ct.size(), m.data())
+                               : romulus_n_decrypt(key.data(), nonce.data(), ad.data(), ad.size(), ct.data(), ct.size(), m.data());
+        if (c != ct || !valid || memcmp(m.data(), pt.data(), pt.size()) != 0)
+        {
+            printf("record %s: failed\n", kat::count(record).c_str());
+            mismatches++;
+        }
+    }
+    fclose(f);
+    printf("%-30s%s (%zu records)\n", label, (records > 0 && mismatches == 0) ? "passed" : "failed", records);
+    return (records > 0 && mismatches == 0) ? 0 : 1;
+}
+
+// Piece sizes used to feed the streaming API
+static const size_t pieces[4] = {1, 7, 16, 33};
+
+int main(int argc, char *argv[])
+{
+    if (argc == 3 && (strcmp(argv[1], "-n") == 0 || strcmp(argv[1], "-m") == 0))
+    {
+        FILE *f = fopen(argv[2], "r");
+        if (f == NULL)
+        {
+            fprintf(stderr, "romulus: cannot open %s\n", argv[2]);
+            return 2;
+        }
+        return check_kat(argv[1][1] == 'm', f, (argv[1][1] == 'm') ? "romulus-m kat:" : "romulus-n kat:");
+    }
+    if (argc != 1)
+    {
+        fprintf(stderr, "usage: %s [-n|-m KAT_FILE]\n", argv[0]);
+        return 2;
+    }
+    const int R = Cipher::ROUNDS;
+    const size_t lengths[] = {0, 1, 15, 16, 17, 31, 32, 33, 48, 63, 64, 100};
+    const int count = sizeof(lengths) / sizeof(lengths[0]);
+    uint8_t key[16], nonce[16], ad[128], msg[128], c[160], c_stream[160], m[128];
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        key[i] = i;
+        nonce[i] = static_cast<uint8_t>(0xf0 ^ i);
+    }
+    for (uint8_t i = 0; i < 128; i++)
+    {
+        ad[i] = static_cast<uint8_t>(3 * i + 1);
+        msg[i] = static_cast<uint8_t>(5 * i + 2);
+    }
+    printf("%-30s", "key:");
+    print_bytes(key, 16);
+    printf("%-30s", "nonce:");
+    print_bytes(nonce, 16);
+    printf("%-30s", "ad / message:");
+    print_bytes(ad, 16);
+    printf("%-30s", "");
+    print_bytes(msg, 20);
+    romulus_n_encrypt(key, nonce, ad, 16, msg, 20, c);
+    printf("%-30s", "romulus-n ciphertext || tag:");
+    print_bytes(c, 36);
+    romulus_m_encrypt(key, nonce, ad, 16, msg, 20, c);
+    printf("%-30s", "romulus-m ciphertext || tag:");
+    print_bytes(c, 36);
+    // TBC: both tweakey paths against the plain tweakey schedule and enc()
+    romulus::Tbc tbc(key, nonce);
+    uint8_t cnt[7], tk[3][16], rtk[R][8], s[16], expected[16];
+    bool tbc_passed = true, all_passed = true;
+    romulus::reset_counter(cnt);
+    for (int j = 0; j < 100; j++)
+    {
+        for (int with_nonce = 0; with_nonce < 2; with_nonce++)
+        {
+            uint8_t domain = static_cast<uint8_t>(j);
+            romulus::Tbc::compose_tk1(cnt, domain, tk[0]);
+            memcpy(tk[1], with_nonce ? nonce : &ad[j % 100], 16);
+            memcpy(tk[2], key, 16);
+            memcpy(s, msg + (j % 100), 16);
+            Cipher::tweakey_schedule(R, tk, rtk);
+            Cipher::enc(R, s, expected, rtk);
+            if (with_nonce)
+                tbc.encrypt_nonce(s, cnt, domain);
+            else
+                tbc.encrypt_tweak(s, cnt, domain, tk[1]);
+            if (memcmp(s, expected, 16) != 0)
+                tbc_passed = false;
+        }
+        romulus::clock_counter(cnt);
+    }
+    printf("%-30s", "tbc (key lane reused):");
+    printf("%s\n", tbc_passed ? "passed" : "failed");
+    all_passed &= tbc_passed;
+    // Both modes against the block-by-block references, every pair of lengths
+    for (int mode = 0; mode < 2; mode++)
+    {
+        bool passed = true;
+        for (int a = 0; a < count; a++)
+            for (int b = 0; b < count; b++)
+            {
+                size_t adlen = lengths[a], mlen = lengths[b];
+                if (mode == 0)
+                {
+                    romulus_n_encrypt(key, nonce, ad, adlen, msg, mlen, c);
+                    reference_n(key, nonce, ad, adlen, msg, mlen, c_stream);
+                }
+                else
+                {
+                    romulus_m_encrypt(key, nonce, ad, adlen, msg, mlen, c);
+                    reference_m(key, nonce, ad, adlen, msg, mlen, c_stream);
+                }
+                if (memcmp(c, c_stream, mlen + 16) != 0)
+                    passed = false;
+            }
+        printf("%-30s", (mode == 0) ? "romulus-n reference:" : "romulus-m reference:");
+        printf("%s\n", passed ? "passed" : "failed");
+        all_passed &= passed;
+    }
+    // Round trip, a forged tag, and the streaming API against the one-shot functions
+    for (int mode = 0; mode < 2; mode++)
+    {
+        bool passed = true;
+        for (int a = 0; a < count; a++)
+            for (int b = 0; b < count; b++)
+            {
+                size_t adlen = lengths[a], mlen = lengths[b];
+                size_t clen = (mode == 0) ? romulus_n_encrypt(key, nonce, ad, adlen, msg, mlen, c)
+                                          : romulus_m_encrypt(key, nonce, ad, adlen, msg, mlen, c);
+                bool valid = (mode == 0) ? romulus_n_decrypt(key, nonce, ad, adlen, c, clen, m)
+                                         : romulus_m_decrypt(key, nonce, ad, adlen, c, clen, m);
+                if (clen != mlen + 16 || !valid || memcmp(m, msg, mlen) != 0)
+                    passed = false;
+                c[clen - 1] ^= 0x80;
+                valid = (mode == 0) ? romulus_n_decrypt(key, nonce, ad, adlen, c, clen, m)
+                                    : romulus_m_decrypt(key, nonce, ad, adlen, c, clen, m);
+                c[clen - 1] ^= 0x80;
+                if (valid)
+                    passed = false;
+                // Streaming, in pieces of 1, 7, 16 and 33 bytes
+                size_t off = 0, written = 0, piece = 0, tail;
+                if (mode == 0)
+                {
+                    RomulusN enc_stream(key, nonce);
+                    for (off = 0; off < adlen; off += pieces[piece++ % 4])
+                        enc_stream.ad(ad + off, min(pieces[piece % 4], adlen - off));
+                    for (off = 0; off < mlen; off += pieces[piece++ % 4])
+                        written += enc_stream.encrypt_update(msg + off, min(pieces[piece % 4], mlen - off), c_stream + written);
+                    written += enc_stream.encrypt_final(c_stream + written, c_stream + mlen);
+                    RomulusN dec_stream(key, nonce);
+                    dec_stream.ad(ad, adlen);
+                    size_t got = 0;
+                    for (off = 0; off < mlen; off += pieces[piece++ % 4])
+                        got += dec_stream.decrypt_update(c + off, min(pieces[piece % 4], mlen - off), m + got);
+                    valid = dec_stream.decrypt_final(m + got, &tail, c + mlen);
+                    if (written != mlen || got + tail != mlen || !valid)
+                        passed = false;
+                }
+                else
+                {
+                    RomulusM enc_stream(key, nonce);
+                    for (off = 0; off < adlen; off += pieces[piece++ % 4])
+                        enc_stream.ad(ad + off, min(pieces[piece % 4], adlen - off));
+                    for (off = 0; off < mlen; off += pieces[piece++ % 4])
+                        enc_stream.message(msg + off, min(pieces[piece % 4], mlen - off));
+                    enc_stream.tag(c_stream + mlen);
+                    enc_stream.start(c_stream + mlen);
+                    for (off = 0; off < mlen; off += pieces[piece++ % 4])
+                        enc_stream.encrypt(msg + off, min(pieces[piece % 4], mlen - off), c_stream + off);
+                    // Single-pass decryption: every decrypted piece goes straight into the MAC
+                    RomulusM dec_stream(key, nonce);
+                    dec_stream.ad(ad, adlen);
+                    dec_stream.start(c + mlen);
+                    for (off = 0; off < mlen; off += pieces[piece++ % 4])
+                    {
+                        size_t len = min(pieces[piece % 4], mlen - off);
+                        dec_stream.decrypt(c + off, len, m + off);
+                        dec_stream.message(m + off, len);
+                    }
+                    if (!dec_stream.verify(c + mlen))
+                        passed = false;
+                }
+                if (memcmp(c_stream, c, clen) != 0 || memcmp(m, msg, mlen) != 0)
+                    passed = false;
+            }
+        printf("%-30s", (mode == 0) ? "romulus-n:" : "romulus-m:");
+        printf("%s\n", passed ? "passed" : "failed");
+        all_passed &= passed;
+    }
+    // The official records pasted above
+    for (int mode = 0; mode < 2; mode++)
+    {
+        const char *label = (mode == 0) ? "romulus-n kat records:" : "romulus-m kat records:";
+        FILE *f = kat::open_text((mode == 0) ? ROMULUS_N_KAT : ROMULUS_M_KAT);
+        if (f == NULL)
+            printf("%-30s%s\n", label, "none embedded");
+        else
+            all_passed &= check_kat(mode == 1, f, label) == 0;
+    }
+    printf("Press Enter to exit ...\n");
+    getchar();
+    return all_passed ? 0 : 1;
+}
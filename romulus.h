@@ -0,0 +1,556 @@
+/*
+ * Romulus-N and Romulus-M authenticated encryption (Romulus v1.3) on Skinny-128-384+
+ * Date: Oct 17, 2026
+*/
+// Key, nonce and tag are 16 bytes. Every TBC call uses the tweakey
+// TK1 = CNT (56-bit LFSR block counter) || D (domain byte) || 0^64, TK2 = nonce or an
+// associated-data block, TK3 = key.
+// RomulusN and RomulusM take the associated data and the message in pieces of any size,
+// so a payload never has to be held in memory as a whole:
+//   RomulusN: ad()*, encrypt_update()* / decrypt_update()*, encrypt_final() / decrypt_final()
+//   RomulusM: first pass ad()*, message()*, tag() / verify(); second pass start(tag),
+//             encrypt()* / decrypt()*. Decryption can feed each decrypted piece to
+//             message() at once, encryption needs the tag and hence two passes.
+// romulus_n_encrypt() and friends are one-shot wrappers (ciphertext || tag).
+
+#ifndef ROMULUS_H
+#define ROMULUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include "skinny.h"
+
+namespace skinny
+{
+
+namespace romulus
+{
+
+// Block counter: LFSR over GF(2^56) (x^56 + x^7 + x^4 + x^2 + 1), cnt[0] least significant
+inline void reset_counter(uint8_t cnt[7])
+{
+    cnt[0] = 0x01;
+    memset(cnt + 1, 0, 6);
+}
+
+inline void clock_counter(uint8_t cnt[7])
+{
+    uint8_t feedback = static_cast<uint8_t>(-(cnt[6] >> 7));
+    for (int i = 6; i > 0; i--)
+        cnt[i] = static_cast<uint8_t>((cnt[i] << 1) | (cnt[i - 1] >> 7));
+    cnt[0] = static_cast<uint8_t>((cnt[0] << 1) ^ (feedback & 0x95));
+}
+
+// len < 16 bytes of data, zeros, len in the last byte; a full block is copied
+inline void pad(const uint8_t *in, size_t len, uint8_t out[16])
+{
+    memset(out, 0, 16);
+    memcpy(out, in, len);
+    if (len < 16)
+        out[15] = static_cast<uint8_t>(len);
+}
+
+// G on one byte: (x7 ... x0) -> (x0 ^ x7, x7, ..., x1)
+inline uint8_t g(uint8_t x)
+{
+    return static_cast<uint8_t>((x >> 1) ^ ((x ^ (x << 7)) & 0x80));
+}
+
+// rho: C = G(S) ^ M, S = S ^ pad(M); in == out is allowed
+inline void rho(uint8_t s[16], const uint8_t *m, uint8_t *c, size_t len)
+{
+    uint8_t mp[16];
+    pad(m, len, mp);
+    for (size_t i = 0; i < len; i++)
+        c[i] = g(s[i]) ^ mp[i];
+    for (uint8_t i = 0; i < 16; i++)
+        s[i] ^= mp[i];
+}
+
+// Inverse of rho: M = G(S) ^ C, S = S ^ pad(M)
+inline void inv_rho(uint8_t s[16], const uint8_t *c, uint8_t *m, size_t len)
+{
+    uint8_t mp[16];
+    for (size_t i = 0; i < len; i++)
+        mp[i] = g(s[i]) ^ c[i];
+    memcpy(m, mp, len);
+    pad(m, len, mp);
+    for (uint8_t i = 0; i < 16; i++)
+        s[i] ^= mp[i];
+}
+
+// rho on associated data, where the output is dropped
+inline void absorb(uint8_t s[16], const uint8_t *data, size_t len)
+{
+    uint8_t dp[16];
+    pad(data, len, dp);
+    for (uint8_t i = 0; i < 16; i++)
+        s[i] ^= dp[i];
+}
+
+inline void tag_of(const uint8_t s[16], uint8_t tag[16])
+{
+    for (uint8_t i = 0; i < 16; i++)
+        tag[i] = g(s[i]);
+}
+
+inline bool tags_equal(const uint8_t a[16], const uint8_t b[16])
+{
+    uint8_t diff = 0;
+    for (uint8_t i = 0; i < 16; i++)
+        diff |= a[i] ^ b[i];
+    return diff == 0;
+}
+
+// The TBC with key and nonce fixed. Calls with the nonce in TK2 (all message blocks) only
+// run the TK1 chain through a tweak context; calls with a data block in TK2 expand TK1 and
+// TK2 and add the key part, expanded once.
+class Tbc
+{
+public:
+    typedef Skinny128_384_plus Cipher;
+    typedef Skinny<128, 256, Cipher::ROUNDS> TweakCipher;
+
+    Tbc(const uint8_t key[16], const uint8_t nonce[16])
+    {
+        uint8_t lanes[3][16];
+        memcpy(lanes[0], nonce, 16);
+        memcpy(lanes[1], key, 16);
+        Cipher::init_tweak_context(&nonce_ctx_, lanes);
+        memset(lanes, 0, 32);
+        memcpy(lanes[2], key, 16);
+        Cipher::expand_key(lanes, key_part_);
+    }
+
+    static void compose_tk1(const uint8_t cnt[7], uint8_t domain, uint8_t tk1[16])
+    {
+        memcpy(tk1, cnt, 7);
+        tk1[7] = domain;
+        memset(tk1 + 8, 0, 8);
+    }
+
+    // s = E(TK1 = cnt || domain, TK2 = nonce, TK3 = key)(s)
+    void encrypt_nonce(uint8_t s[16], const uint8_t cnt[7], uint8_t domain) const
+    {
+        uint8_t tk1[16];
+        Cipher::Key key;
+        compose_tk1(cnt, domain, tk1);
+        Cipher::tweak_key(&nonce_ctx_, tk1, key);
+        Cipher::encrypt(key, s, s);
+    }
+
+    // s = E(TK1 = cnt || domain, TK2 = tweak, TK3 = key)(s)
+    void encrypt_tweak(uint8_t s[16], const uint8_t cnt[7], uint8_t domain, const uint8_t tweak[16]) const
+    {
+        uint8_t tk[2][16];
+        TweakCipher::Key tweak_part;
+        Cipher::Key key;
+        compose_tk1(cnt, domain, tk[0]);
+        memcpy(tk[1], tweak, 16);
+        TweakCipher::expand_key(tk, tweak_part);
+        for (int r = 0; r < Cipher::ROUNDS; r++)
+        {
+            key.rtk[r][0] = tweak_part.rtk[r][0] ^ key_part_.rtk[r][0];
+            key.rtk[r][1] = tweak_part.rtk[r][1] ^ key_part_.rtk[r][1];
+        }
+        Cipher::encrypt(key, s, s);
+    }
+
+private:
+    Cipher::TweakContext nonce_ctx_;
+    Cipher::Key key_part_;
+};
+
+} // namespace romulus
+
+class RomulusN
+{
+public:
+    static const int KEY_BYTES = 16;
+    static const int NONCE_BYTES = 16;
+    static const int TAG_BYTES = 16;
+
+    RomulusN(const uint8_t key[16], const uint8_t nonce[16]) : tbc_(key, nonce)
+    {
+        memset(s_, 0, 16);
+        romulus::reset_counter(cnt_);
+    }
+
+    // Associated data, all of it before the message
+    void ad(const uint8_t *data, size_t len)
+    {
+        ad_len_ += len;
+        while (len > 0)
+        {
+            size_t take = std::min(32 - buf_len_, len);
+            memcpy(buf_ + buf_len_, data, take);
+            buf_len_ += take;
+            data += take;
+            len -= take;
+            if (buf_len_ == 32)
+            {
+                ad_pair(buf_, 16);
+                buf_len_ = 0;
+            }
+        }
+    }
+
+    // The last block is held back until the final call (its domain differs), so these
+    // write the output of the blocks known not to be the last: up to len + 15 bytes.
+    // Returns the number of bytes written; in == out is allowed.
+    size_t encrypt_update(const uint8_t *in, size_t len, uint8_t *out) { return update(in, len, out, false); }
+    size_t decrypt_update(const uint8_t *in, size_t len, uint8_t *out) { return update(in, len, out, true); }
+
+    // Writes the held-back bytes (at most 16) to out and the tag; returns their number
+    size_t encrypt_final(uint8_t *out, uint8_t tag[16])
+    {
+        size_t written = final_block(out, false);
+        romulus::tag_of(s_, tag);
+        return written;
+    }
+
+    // Same, and checks the tag; the plaintext must be discarded if this returns false
+    bool decrypt_final(uint8_t *out, size_t *written, const uint8_t tag[16])
+    {
+        uint8_t expected[16];
+        *written = final_block(out, true);
+        romulus::tag_of(s_, expected);
+        return romulus::tags_equal(expected, tag);
+    }
+
+private:
+    // rho on the first block, the TBC with the second one (len bytes) as TK2
+    void ad_pair(const uint8_t pair[32], size_t len)
+    {
+        uint8_t tweak[16];
+        romulus::absorb(s_, pair, 16);
+        romulus::clock_counter(cnt_);
+        romulus::pad(pair + 16, len, tweak);
+        tbc_.encrypt_tweak(s_, cnt_, 8, tweak);
+        romulus::clock_counter(cnt_);
+    }
+
+    void finish_ad()
+    {
+        if (message_)
+            return;
+        // Domain of the nonce call: 26 if the last block of associated data was partial
+        uint8_t w = 24;
+        if (ad_len_ == 0)
+        {
+            romulus::clock_counter(cnt_);
+            w = 26;
+        }
+        else if (buf_len_ > 16)
+        {
+            ad_pair(buf_, buf_len_ - 16);
+            w = 26;
+        }
+        else if (buf_len_ > 0)
+        {
+            romulus::absorb(s_, buf_, buf_len_);
+            romulus::clock_counter(cnt_);
+            w = (buf_len_ < 16) ? 26 : 24;
+        }
+        tbc_.encrypt_nonce(s_, cnt_, w);
+        romulus::reset_counter(cnt_);
+        buf_len_ = 0;
+        message_ = true;
+    }
+
+    void message_block(const uint8_t *in, size_t len, uint8_t *out, bool decrypt, uint8_t domain)
+    {
+        if (decrypt)
+            romulus::inv_rho(s_, in, out, len);
+        else
+            romulus::rho(s_, in, out, len);
+        romulus::clock_counter(cnt_);
+        tbc_.encrypt_nonce(s_, cnt_, domain);
+    }
+
+    size_t update(const uint8_t *in, size_t len, uint8_t *out, bool decrypt)
+    {
+        size_t written = 0;
+        finish_ad();
+        while (len > 0)
+        {
+            // A full buffer with more data behind it is not the last block
+            if (buf_len_ == 16)
+            {
+                message_block(buf_, 16, out + written, decrypt, 4);
+                written += 16;
+                buf_len_ = 0;
+            }
+            for (; buf_len_ == 0 && len > 16; in += 16, len -= 16, written += 16)
+                message_block(in, 16, out + written, decrypt, 4);
+            size_t take = std::min(16 - buf_len_, len);
+            memcpy(buf_ + buf_len_, in, take);
+            buf_len_ += take;
+            in += take;
+            len -= take;
+        }
+        return written;
+    }
+
+    size_t final_block(uint8_t *out, bool decrypt)
+    {
+        finish_ad();
+        size_t len = buf_len_;
+        // An empty message is one empty block
+        message_block(buf_, len, out, decrypt, (len < 16) ? 21 : 20);
+        buf_len_ = 0;
+        return len;
+    }
+
+    romulus::Tbc tbc_;
+    uint8_t s_[16];
+    uint8_t cnt_[7];
+    uint8_t buf_[32];
+    size_t buf_len_ = 0;
+    uint64_t ad_len_ = 0;
+    bool message_ = false;
+};
+
+class RomulusM
+{
+public:
+    static const int KEY_BYTES = 16;
+    static const int NONCE_BYTES = 16;
+    static const int TAG_BYTES = 16;
+
+    RomulusM(const uint8_t key[16], const uint8_t nonce[16]) : tbc_(key, nonce)
+    {
+        memset(s_, 0, 16);
+        romulus::reset_counter(cnt_);
+    }
+
+    // First pass: the associated data, then the plaintext
+    void ad(const uint8_t *data, size_t len)
+    {
+        ad_len_ += len;
+        absorb(data, len, 40);
+    }
+
+    void message(const uint8_t *data, size_t len)
+    {
+        finish_ad();
+        msg_len_ += len;
+        // After an odd number of associated-data blocks the first message block is a TK2
+        while (len > 0 && tweak_first_)
+        {
+            size_t take = std::min(16 - buf_len_, len);
+            memcpy(buf_ + buf_len_, data, take);
+            buf_len_ += take;
+            data += take;
+            len -= take;
+            if (buf_len_ == 16)
+            {
+                tweak_block(16);
+                buf_len_ = 0;
+                tweak_first_ = false;
+            }
+        }
+        absorb(data, len, 44);
+    }
+
+    void tag(uint8_t tag[16])
+    {
+        finish_ad();
+        if (tweak_first_)
+            tweak_block(buf_len_);
+        else if (buf_len_ > 16)
+            pair(buf_, buf_len_ - 16, 44);
+        else if (buf_len_ > 0 || msg_len_ == 0)
+        {
+            // An empty message is one empty odd block, as in the domain below
+            romulus::absorb(s_, buf_, buf_len_);
+            romulus::clock_counter(cnt_);
+        }
+        // Domain of the nonce call: parity and fullness of the last blocks of both inputs
+        uint8_t w = 48;
+        uint64_t m = (msg_len_ + 15) / 16;
+        if (!ad_odd_)
+            w ^= 8;
+        if (ad_partial_)
+            w ^= 2;
+        if (m > 0 && m % 2 == 0)
+            w ^= 4;
+        if (msg_len_ == 0 || msg_len_ % 16 != 0)
+            w ^= 1;
+        tbc_.encrypt_nonce(s_, cnt_, w);
+        romulus::tag_of(s_, tag);
+    }
+
+    bool verify(const uint8_t expected[16])
+    {
+        uint8_t computed[16];
+        tag(computed);
+        return romulus::tags_equal(computed, expected);
+    }
+
+    // Second pass, keyed by the tag; encrypt() and decrypt() write exactly len bytes
+    void start(const uint8_t tag[16])
+    {
+        memcpy(enc_s_, tag, 16);
+        romulus::reset_counter(enc_cnt_);
+        enc_pos_ = 0;
+    }
+
+    void encrypt(const uint8_t *in, size_t len, uint8_t *out) { crypt(in, len, out, false); }
+    void decrypt(const uint8_t *in, size_t len, uint8_t *out) { crypt(in, len, out, true); }
+
+private:
+    void pair(const uint8_t pair[32], size_t len, uint8_t domain)
+    {
+        uint8_t tweak[16];
+        romulus::absorb(s_, pair, 16);
+        romulus::clock_counter(cnt_);
+        romulus::pad(pair + 16, len, tweak);
+        tbc_.encrypt_tweak(s_, cnt_, domain, tweak);
+        romulus::clock_counter(cnt_);
+    }
+
+    // The first message block (len bytes in buf_) as TK2 of the pair the last odd
+    // associated-data block started
+    void tweak_block(size_t len)
+    {
+        uint8_t tweak[16];
+        romulus::pad(buf_, len, tweak);
+        tbc_.encrypt_tweak(s_, cnt_, 44, tweak);
+        romulus::clock_counter(cnt_);
+    }
+
+    // Full pairs are processed as they complete, whether or not they are the last
+    void absorb(const uint8_t *data, size_t len, uint8_t domain)
+    {
+        while (len > 0)
+        {
+            size_t take = std::min(32 - buf_len_, len);
+            memcpy(buf_ + buf_len_, data, take);
+            buf_len_ += take;
+            data += take;
+            len -= take;
+            if (buf_len_ == 32)
+            {
+                pair(buf_, 16, domain);
+                buf_len_ = 0;
+            }
+        }
+    }
+
+    void finish_ad()
+    {
+        if (message_)
+            return;
+        // Empty associated data is one empty block
+        ad_odd_ = (ad_len_ == 0) || (buf_len_ > 0 && buf_len_ <= 16);
+        ad_partial_ = (ad_len_ == 0) || (buf_len_ % 16 != 0);
+        if (ad_len_ == 0)
+            romulus::clock_counter(cnt_);
+        else if (buf_len_ > 16)
+            pair(buf_, buf_len_ - 16, 40);
+        else if (buf_len_ > 0)
+        {
+            romulus::absorb(s_, buf_, buf_len_);
+            romulus::clock_counter(cnt_);
+        }
+        tweak_first_ = ad_odd_;
+        buf_len_ = 0;
+        message_ = true;
+    }
+
+    void crypt(const uint8_t *in, size_t len, uint8_t *out, bool decrypt)
+    {
+        // Bytewise rho: the padding of the last block does not matter, S is not used after it
+        for (size_t i = 0; i < len; i++)
+        {
+            if (enc_pos_ == 16)
+            {
+                romulus::clock_counter(enc_cnt_);
+                enc_pos_ = 0;
+            }
+            if (enc_pos_ == 0)
+                tbc_.encrypt_nonce(enc_s_, enc_cnt_, 36);
+            uint8_t x = in[i];
+            out[i] = x ^ romulus::g(enc_s_[enc_pos_]);
+            enc_s_[enc_pos_++] ^= decrypt ? out[i] : x;
+        }
+    }
+
+    romulus::Tbc tbc_;
+    uint8_t s_[16];
+    uint8_t cnt_[7];
+    uint8_t buf_[32];
+    size_t buf_len_ = 0;
+    uint64_t ad_len_ = 0;
+    uint64_t msg_len_ = 0;
+    bool message_ = false;
+    bool ad_odd_ = false;
+    bool ad_partial_ = false;
+    bool tweak_first_ = false;
+    uint8_t enc_s_[16];
+    uint8_t enc_cnt_[7];
+    int enc_pos_ = 0;
+};
+
+// c = ciphertext || tag (mlen + 16 bytes); returns the length of c
+inline size_t romulus_n_encrypt(const uint8_t key[16], const uint8_t nonce[16], const uint8_t *ad, size_t adlen,
+                                const uint8_t *m, size_t mlen, uint8_t *c)
+{
+    RomulusN aead(key, nonce);
+    aead.ad(ad, adlen);
+    size_t written = aead.encrypt_update(m, mlen, c);
+    written += aead.encrypt_final(c + written, c + mlen);
+    return written + 16;
+}
+
+// Returns false (and zeroes m) if the tag does not match
+inline bool romulus_n_decrypt(const uint8_t key[16], const uint8_t nonce[16], const uint8_t *ad, size_t adlen,
+                              const uint8_t *c, size_t clen, uint8_t *m)
+{
+    if (clen < 16)
+        return false;
+    RomulusN aead(key, nonce);
+    size_t mlen = clen - 16, tail;
+    aead.ad(ad, adlen);
+    size_t written = aead.decrypt_update(c, mlen, m);
+    bool valid = aead.decrypt_final(m + written, &tail, c + mlen);
+    if (!valid)
+        memset(m, 0, mlen);
+    return valid;
+}
+
+inline size_t romulus_m_encrypt(const uint8_t key[16], const uint8_t nonce[16], const uint8_t *ad, size_t adlen,
+                                const uint8_t *m, size_t mlen, uint8_t *c)
+{
+    RomulusM aead(key, nonce);
+    aead.ad(ad, adlen);
+    aead.message(m, mlen);
+    aead.tag(c + mlen);
+    aead.start(c + mlen);
+    aead.encrypt(m, mlen, c);
+    return mlen + 16;
+}
+
+inline bool romulus_m_decrypt(const uint8_t key[16], const uint8_t nonce[16], const uint8_t *ad, size_t adlen,
+                              const uint8_t *c, size_t clen, uint8_t *m)
+{
+    if (clen < 16)
+        return false;
+    RomulusM aead(key, nonce);
+    size_t mlen = clen - 16;
+    aead.start(c + mlen);
+    aead.decrypt(c, mlen, m);
+    aead.ad(ad, adlen);
+    aead.message(m, mlen);
+    bool valid = aead.verify(c + mlen);
+    if (!valid)
+        memset(m, 0, mlen);
+    return valid;
+}
+
+} // namespace skinny
+
+#endif
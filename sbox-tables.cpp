@@ -0,0 +1,126 @@
+/*
+ * DDT, LAT, BCT and DLCT of the Skinny S-boxes
+ * Date: Oct 17, 2026
+*/
+// Usage: sbox-tables.o [CACHE_DIR [SUPERBOX_KEY]]
+// Prints the uniformity of every table and checks the fast tables against the
+// definitions. With a cache directory, the tables are loaded from or stored into it; with
+// a super-box key (4 hex digits) as well, the 2^32-pair super-box summary of Skinny-64 for
+// that key is computed (or loaded) and its best transition printed. A table that cannot be
+// stored in the cache directory is reported on stderr.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "sbox_tables.h"
+
+using namespace std;
+using namespace skinny;
+
+int brute_force(SboxId id, TableKind kind, int a, int b);
+
+// The tables straight from their definitions
+int brute_force(SboxId id, TableKind kind, int a, int b)
+{
+    const uint8_t *s = sbox_of(id), *s_inv = inverse_of(id);
+    const int size = 1 << sbox_bits(id);
+    int count = 0;
+    for (int x = 0; x < size; x++)
+        switch (kind)
+        {
+        case TABLE_DDT:
+            count += (s[x] ^ s[x ^ a]) == b;
+            break;
+        case TABLE_LAT:
+            count += __builtin_parity(a & x) == __builtin_parity(b & s[x]);
+            break;
+        case TABLE_BCT:
+            count += (s_inv[s[x] ^ b] ^ s_inv[s[x ^ a] ^ b]) == a;
+            break;
+        default:
+            count += __builtin_parity(b & s[x]) == __builtin_parity(b & s[x ^ a]);
+            break;
+        }
+    return (kind == TABLE_LAT || kind == TABLE_DLCT) ? count - size / 2 : count;
+}
+
+int main(int argc, char *argv[])
+{
+    const SboxId sboxes[4] = {SBOX4, SBOX4_INV, SBOX8, SBOX8_INV};
+    const TableKind kinds[4] = {TABLE_DDT, TABLE_LAT, TABLE_BCT, TABLE_DLCT};
+    WorkStealingPool pool;
+    bool tables_passed = true, cache_passed = true;
+    for (SboxId id : sboxes)
+    {
+        printf("%-30s", (string(sbox_name(id)) + ":").c_str());
+        for (TableKind kind : kinds)
+        {
+            bool saved = true;
+            SboxTable t = (argc > 1) ? cached_table(id, kind, argv[1], &pool, &saved) : compute_table(id, kind, &pool);
+            if (!saved)
+                fprintf(stderr, "%s: cannot store the table\n", table_path(argv[1], id, kind).c_str());
+            for (int a = 0; a < t.size(); a++)
+                for (int b = 0; b < t.size(); b++)
+                    if (t.at(a, b) != brute_force(id, kind, a, b))
+                        tables_passed = false;
+            printf("%s %d  ", table_name(kind), t.uniformity());
+            // Cache round trip, and a damaged file is refused
+            if (kind == TABLE_BCT && (id == SBOX4 || id == SBOX8))
+            {
+                const string path = "sbox-tables-check.tbl";
+                SboxTable loaded;
+                if (!save_table(t, path) || !load_table(path, id, kind, loaded) || loaded.entries() != t.entries() ||
+                    load_table(path, id, TABLE_DDT, loaded))
+                    cache_passed = false;
+                FILE *f = fopen(path.c_str(), "r+b");
+                if (f != NULL)
+                {
+                    fseek(f, 40, SEEK_SET);
+                    fputc(0x55, f);
+                    fclose(f);
+                }
+                if (load_table(path, id, kind, loaded))
+                    cache_passed = false;
+                remove(path.c_str());
+                // A missing cache directory still gives the table, and says it was not stored
+                bool saved = true;
+                if (cached_table(id, kind, "sbox-tables-missing", &pool, &saved).entries() != t.entries() || saved)
+                    cache_passed = false;
+            }
+        }
+        printf("\n");
+    }
+    printf("%-30s%s\n", "tables:", tables_passed ? "passed" : "failed");
+    printf("%-30s%s\n", "cache:", cache_passed ? "passed" : "failed");
+    // Super-box rows against superbox64() itself
+    vector<uint16_t> values;
+    vector<uint32_t> counts(1 << 16), expected(1 << 16);
+    bool superbox_passed = true;
+    superbox64_values(0x0021, values);
+    for (uint32_t a : {0x0001u, 0x0010u, 0x1100u, 0xffffu})
+    {
+        superbox64_ddt_row(values, static_cast<uint16_t>(a), counts.data());
+        fill(expected.begin(), expected.end(), 0);
+        for (uint32_t x = 0; x < (1 << 16); x++)
+            expected[superbox64(static_cast<uint16_t>(x), 0x0021) ^ superbox64(static_cast<uint16_t>(x ^ a), 0x0021)]++;
+        if (counts != expected)
+            superbox_passed = false;
+    }
+    printf("%-30s%s\n", "superbox rows:", superbox_passed ? "passed" : "failed");
+    if (argc > 2)
+    {
+        uint16_t key = static_cast<uint16_t>(strtoul(argv[2], NULL, 16));
+        bool saved;
+        SuperboxSummary s = cached_superbox64_summary(key, argv[1], &pool, &saved);
+        if (!saved)
+            fprintf(stderr, "%s: cannot store the summary\n", superbox64_path(argv[1], key).c_str());
+        uint32_t best = 1;
+        for (uint32_t a = 1; a < (1 << 16); a++)
+            if (s.best_count[a] > s.best_count[best])
+                best = a;
+        printf("%-30s%04x -> %04x: %u / 65536\n", "superbox best:", best, s.best_output[best], s.best_count[best]);
+    }
+    return (tables_passed && cache_passed && superbox_passed) ? 0 : 1;
+}
@@ -0,0 +1,502 @@
+/*
+ * DDT, LAT, BCT and DLCT of the Skinny S-boxes, with a disk cache
+ * Date: Oct 17, 2026
+*/
+// compute_table() fills, for S = S4, S4inv, S8 or S8inv (n = 4 or 8 bits), one of
+//   DDT[a][b]  = #{x : S(x) ^ S(x ^ a) = b}
+//   LAT[a][b]  = #{x : a.x = b.S(x)} - 2^(n-1)
+//   BCT[a][b]  = #{x : S^-1(S(x) ^ b) ^ S^-1(S(x ^ a) ^ b) = a}
+//   DLCT[a][b] = #{x : b.S(x) = b.S(x ^ a)} - 2^(n-1)
+// LAT columns and DLCT rows are Walsh-Hadamard transforms (of (-1)^(b.S(x)) and of a DDT
+// row), computed with AVX2 butterflies; the BCT compares 32 values of x at a time through
+// AVX2 byte lookups. Rows (columns for the LAT) are spread over a WorkStealingPool if one is
+// given. cached_table() loads a table from the cache directory, or computes and stores it.
+//
+// Super-box of Skinny-64: the S-boxes of one column, a 16-bit key (round constants and
+// tweakey of that column), MixColumns and the S-boxes again. Its DDT has 2^32 entries, too
+// many to keep, so superbox64_ddt_row() computes one row on demand and superbox64_summary()
+// counts all 2^32 pairs to keep, per input difference, the best output difference, its
+// count and the number of possible output differences.
+//
+// File format (little-endian): "SKTB", version, kind, S-box, bytes per entry, rows and
+// columns (uint32), the FNV-1a hash of the entries (uint32), then the entries row by row.
+
+#ifndef SBOX_TABLES_H
+#define SBOX_TABLES_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#include "skinny.h"
+#include "skinny_dispatch.h"
+#include "work_pool.h"
+
+namespace skinny
+{
+
+enum SboxId
+{
+    SBOX4,
+    SBOX4_INV,
+    SBOX8,
+    SBOX8_INV
+};
+
+enum TableKind
+{
+    TABLE_DDT,
+    TABLE_LAT,
+    TABLE_BCT,
+    TABLE_DLCT,
+    TABLE_SUPERBOX64
+};
+
+inline int sbox_bits(SboxId id) { return (id == SBOX4 || id == SBOX4_INV) ? 4 : 8; }
+
+inline const uint8_t *sbox_of(SboxId id)
+{
+    static const uint8_t *const sboxes[4] = {S4, S4inv, S8, S8inv};
+    return sboxes[id];
+}
+
+inline const uint8_t *inverse_of(SboxId id)
+{
+    static const uint8_t *const sboxes[4] = {S4inv, S4, S8inv, S8};
+    return sboxes[id];
+}
+
+inline const char *sbox_name(SboxId id)
+{
+    static const char *const names[4] = {"s4", "s4inv", "s8", "s8inv"};
+    return names[id];
+}
+
+inline const char *table_name(TableKind kind)
+{
+    static const char *const names[5] = {"ddt", "lat", "bct", "dlct", "superbox64"};
+    return names[kind];
+}
+
+class SboxTable
+{
+public:
+    SboxTable() : sbox_(SBOX8), kind_(TABLE_DDT), size_(0) {}
+    SboxTable(SboxId sbox, TableKind kind) : sbox_(sbox), kind_(kind), size_(1 << sbox_bits(sbox)), entries_(size_ * size_, 0) {}
+
+    SboxId sbox() const { return sbox_; }
+    TableKind kind() const { return kind_; }
+    int size() const { return size_; }
+    int16_t at(int a, int b) const { return entries_[a * size_ + b]; }
+    int16_t *row(int a) { return &entries_[a * size_]; }
+    const int16_t *row(int a) const { return &entries_[a * size_]; }
+    const std::vector<int16_t> &entries() const { return entries_; }
+    std::vector<int16_t> &entries() { return entries_; }
+
+    // Largest entry outside row and column 0 (absolute value for the LAT and the DLCT)
+    int uniformity() const
+    {
+        int best = 0;
+        for (int a = 1; a < size_; a++)
+            for (int b = 1; b < size_; b++)
+                best = std::max(best, std::abs(static_cast<int>(at(a, b))));
+        return best;
+    }
+
+private:
+    SboxId sbox_;
+    TableKind kind_;
+    int size_;
+    std::vector<int16_t> entries_;
+};
+
+namespace tables
+{
+
+inline int parity(unsigned x) { return __builtin_parity(x); }
+
+inline void fwht_scalar(int32_t *f, int size)
+{
+    for (int h = 1; h < size; h *= 2)
+        for (int i = 0; i < size; i += 2 * h)
+            for (int j = i; j < i + h; j++)
+            {
+                int32_t a = f[j], b = f[j + h];
+                f[j] = a + b;
+                f[j + h] = a - b;
+            }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Butterflies of span 8 and more on 8 lanes at a time, the smaller ones in scalar code
+__attribute__((target("avx2"))) inline void fwht_avx2(int32_t *f, int size)
+{
+    if (size < 16)
+    {
+        fwht_scalar(f, size);
+        return;
+    }
+    for (int i = 0; i < size; i += 8)
+        fwht_scalar(f + i, 8);
+    for (int h = 8; h < size; h *= 2)
+        for (int i = 0; i < size; i += 2 * h)
+            for (int j = i; j < i + h; j += 8)
+            {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(f + j));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(f + j + h));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(f + j), _mm256_add_epi32(a, b));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(f + j + h), _mm256_sub_epi32(a, b));
+            }
+}
+
+// table[v] for 32 bytes v: one shuffle per 16-entry slice, selected by the high nibble
+__attribute__((target("avx2"))) inline __m256i lookup_avx2(const __m256i slices[16], __m256i v)
+{
+    const __m256i low = _mm256_and_si256(v, _mm256_set1_epi8(0x0f));
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+    __m256i r = _mm256_setzero_si256();
+    for (int h = 0; h < 16; h++)
+    {
+        const __m256i selected = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(static_cast<char>(h)));
+        r = _mm256_or_si256(r, _mm256_and_si256(_mm256_shuffle_epi8(slices[h], low), selected));
+    }
+    return r;
+}
+
+// BCT row a of an 8-bit S-box, 32 values of x per step
+__attribute__((target("avx2"))) inline void bct_row_avx2(const uint8_t s[256], const uint8_t s_inv[256], int a, int16_t *row)
+{
+    __m256i slices[16], sx[8], sxa[8];
+    alignas(32) uint8_t buffer[256];
+    for (int h = 0; h < 16; h++)
+        slices[h] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s_inv + 16 * h)));
+    for (int x = 0; x < 256; x++)
+        buffer[x] = s[x ^ a];
+    for (int k = 0; k < 8; k++)
+    {
+        sx[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + 32 * k));
+        sxa[k] = _mm256_load_si256(reinterpret_cast<const __m256i *>(buffer + 32 * k));
+    }
+    const __m256i target = _mm256_set1_epi8(static_cast<char>(a));
+    for (int b = 0; b < 256; b++)
+    {
+        const __m256i vb = _mm256_set1_epi8(static_cast<char>(b));
+        int count = 0;
+        for (int k = 0; k < 8; k++)
+        {
+            __m256i u = lookup_avx2(slices, _mm256_xor_si256(sx[k], vb));
+            __m256i w = lookup_avx2(slices, _mm256_xor_si256(sxa[k], vb));
+            count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_xor_si256(u, w), target))));
+        }
+        row[b] = static_cast<int16_t>(count);
+    }
+}
+#endif
+
+inline void fwht(int32_t *f, int size)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (cpu_supports(ISA_AVX2))
+    {
+        fwht_avx2(f, size);
+        return;
+    }
+#endif
+    fwht_scalar(f, size);
+}
+
+inline void ddt_row(const uint8_t *s, int size, int a, int16_t *row)
+{
+    memset(row, 0, size * sizeof(int16_t));
+    for (int x = 0; x < size; x++)
+        row[s[x] ^ s[x ^ a]]++;
+}
+
+inline void bct_row(const uint8_t *s, const uint8_t *s_inv, int size, int a, int16_t *row)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (size == 256 && cpu_supports(ISA_AVX2))
+    {
+        bct_row_avx2(s, s_inv, a, row);
+        return;
+    }
+#endif
+    for (int b = 0; b < size; b++)
+    {
+        int count = 0;
+        for (int x = 0; x < size; x++)
+            count += (s_inv[s[x] ^ b] ^ s_inv[s[x ^ a] ^ b]) == a;
+        row[b] = static_cast<int16_t>(count);
+    }
+}
+
+inline void run(WorkStealingPool *pool, size_t tasks, const std::function<void(size_t)> &task)
+{
+    if (pool != NULL)
+        pool->run(tasks, task);
+    else
+        for (size_t t = 0; t < tasks; t++)
+            task(t);
+}
+
+inline uint32_t fnv1a(const uint8_t *bytes, size_t length)
+{
+    uint32_t h = 0x811c9dc5;
+    for (size_t i = 0; i < length; i++)
+        h = (h ^ bytes[i]) * 0x01000193;
+    return h;
+}
+
+inline void put32(uint8_t *p, uint32_t v)
+{
+    for (int k = 0; k < 4; k++)
+        p[k] = static_cast<uint8_t>(v >> (8 * k));
+}
+
+inline uint32_t get32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// entries: rows * cols little-endian values of entry_bytes bytes each
+inline bool save_entries(const std::string &path, uint8_t kind, uint8_t sbox, uint8_t entry_bytes, uint32_t rows, uint32_t cols,
+                         const std::vector<uint8_t> &entries)
+{
+    uint8_t header[20] = {'S', 'K', 'T', 'B', 1, kind, sbox, entry_bytes};
+    put32(header + 8, rows);
+    put32(header + 12, cols);
+    put32(header + 16, fnv1a(entries.data(), entries.size()));
+    // Written under a temporary name and renamed, so readers never see half a table
+    std::string partial = path + ".part";
+    FILE *f = fopen(partial.c_str(), "wb");
+    if (f == NULL)
+        return false;
+    bool ok = fwrite(header, 1, sizeof(header), f) == sizeof(header) && fwrite(entries.data(), 1, entries.size(), f) == entries.size();
+    ok = (fclose(f) == 0) && ok;
+    if (ok)
+        ok = rename(partial.c_str(), path.c_str()) == 0;
+    if (!ok)
+        remove(partial.c_str());
+    return ok;
+}
+
+inline bool load_entries(const std::string &path, uint8_t kind, uint8_t sbox, uint8_t entry_bytes, uint32_t rows, uint32_t cols,
+                         std::vector<uint8_t> &entries)
+{
+    uint8_t header[20];
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == NULL)
+        return false;
+    entries.assign(static_cast<size_t>(rows) * cols * entry_bytes, 0);
+    bool ok = fread(header, 1, sizeof(header), f) == sizeof(header) && fread(entries.data(), 1, entries.size(), f) == entries.size() &&
+              fgetc(f) == EOF;
+    fclose(f);
+    return ok && memcmp(header, "SKTB", 4) == 0 && header[4] == 1 && header[5] == kind && header[6] == sbox && header[7] == entry_bytes &&
+           get32(header + 8) == rows && get32(header + 12) == cols && get32(header + 16) == fnv1a(entries.data(), entries.size());
+}
+
+} // namespace tables
+
+inline SboxTable compute_table(SboxId sbox, TableKind kind, WorkStealingPool *pool = NULL)
+{
+    SboxTable t(sbox, kind);
+    const uint8_t *s = sbox_of(sbox), *s_inv = inverse_of(sbox);
+    const int size = t.size();
+    switch (kind)
+    {
+    case TABLE_DDT:
+        tables::run(pool, size, [&](size_t a) { tables::ddt_row(s, size, static_cast<int>(a), t.row(static_cast<int>(a))); });
+        break;
+    case TABLE_LAT:
+        tables::run(pool, size, [&](size_t b) {
+            int32_t f[256];
+            for (int x = 0; x < size; x++)
+                f[x] = tables::parity(b & s[x]) ? -1 : 1;
+            tables::fwht(f, size);
+            for (int a = 0; a < size; a++)
+                t.row(a)[b] = static_cast<int16_t>(f[a] / 2);
+        });
+        break;
+    case TABLE_BCT:
+        tables::run(pool, size, [&](size_t a) { tables::bct_row(s, s_inv, size, static_cast<int>(a), t.row(static_cast<int>(a))); });
+        break;
+    case TABLE_DLCT:
+        tables::run(pool, size, [&](size_t a) {
+            int16_t ddt[256];
+            int32_t f[256];
+            tables::ddt_row(s, size, static_cast<int>(a), ddt);
+            for (int y = 0; y < size; y++)
+                f[y] = ddt[y];
+            tables::fwht(f, size);
+            for (int b = 0; b < size; b++)
+                t.row(static_cast<int>(a))[b] = static_cast<int16_t>(f[b] / 2);
+        });
+        break;
+    default:
+        break;
+    }
+    return t;
+}
+
+inline std::string table_path(const std::string &dir, SboxId sbox, TableKind kind)
+{
+    return dir + "/skinny-" + sbox_name(sbox) + "-" + table_name(kind) + ".tbl";
+}
+
+inline bool save_table(const SboxTable &t, const std::string &path)
+{
+    std::vector<uint8_t> bytes(2 * t.entries().size());
+    for (size_t i = 0; i < t.entries().size(); i++)
+    {
+        bytes[2 * i] = static_cast<uint8_t>(t.entries()[i]);
+        bytes[2 * i + 1] = static_cast<uint8_t>(static_cast<uint16_t>(t.entries()[i]) >> 8);
+    }
+    return tables::save_entries(path, t.kind(), t.sbox(), 2, t.size(), t.size(), bytes);
+}
+
+// False if the file is missing, damaged or holds another table
+inline bool load_table(const std::string &path, SboxId sbox, TableKind kind, SboxTable &t)
+{
+    std::vector<uint8_t> bytes;
+    SboxTable loaded(sbox, kind);
+    if (!tables::load_entries(path, kind, sbox, 2, loaded.size(), loaded.size(), bytes))
+        return false;
+    for (size_t i = 0; i < loaded.entries().size(); i++)
+        loaded.entries()[i] = static_cast<int16_t>(bytes[2 * i] | (bytes[2 * i + 1] << 8));
+    t = loaded;
+    return true;
+}
+
+// Loaded from dir, or computed and stored there; *saved (if given) is false when the
+// table had to be computed and could not be stored, so the next call computes it again
+inline SboxTable cached_table(SboxId sbox, TableKind kind, const std::string &dir = ".", WorkStealingPool *pool = NULL,
+                              bool *saved = NULL)
+{
+    SboxTable t;
+    std::string path = table_path(dir, sbox, kind);
+    bool stored = load_table(path, sbox, kind, t);
+    if (!stored)
+    {
+        t = compute_table(sbox, kind, pool);
+        stored = save_table(t, path);
+    }
+    if (saved != NULL)
+        *saved = stored;
+    return t;
+}
+
+// x holds cell i of the column in bits 4i to 4i + 3, as does the key
+inline uint16_t superbox64(uint16_t x, uint16_t key)
+{
+    uint8_t c[4];
+    for (int i = 0; i < 4; i++)
+        c[i] = S4[(x >> (4 * i)) & 0xf] ^ ((key >> (4 * i)) & 0xf);
+    uint8_t m[4] = {static_cast<uint8_t>(c[0] ^ c[2] ^ c[3]), c[0], static_cast<uint8_t>(c[1] ^ c[2]), static_cast<uint8_t>(c[0] ^ c[2])};
+    uint16_t y = 0;
+    for (int i = 0; i < 4; i++)
+        y |= static_cast<uint16_t>(S4[m[i]] << (4 * i));
+    return y;
+}
+
+inline void superbox64_values(uint16_t key, std::vector<uint16_t> &values)
+{
+    values.resize(1 << 16);
+    for (uint32_t x = 0; x < (1 << 16); x++)
+        values[x] = superbox64(static_cast<uint16_t>(x), key);
+}
+
+// counts[b] = #{x : F(x) ^ F(x ^ a) = b}, values = F from superbox64_values()
+inline void superbox64_ddt_row(const std::vector<uint16_t> &values, uint16_t a, uint32_t counts[1 << 16])
+{
+    memset(counts, 0, sizeof(uint32_t) << 16);
+    for (uint32_t x = 0; x < (1 << 16); x++)
+        counts[values[x] ^ values[x ^ a]]++;
+}
+
+struct SuperboxSummary
+{
+    uint16_t key;
+    std::vector<uint32_t> best_output; // per input difference
+    std::vector<uint32_t> best_count;
+    std::vector<uint32_t> outputs; // output differences of nonzero count
+};
+
+inline SuperboxSummary superbox64_summary(uint16_t key, WorkStealingPool *pool = NULL)
+{
+    SuperboxSummary s;
+    std::vector<uint16_t> values;
+    superbox64_values(key, values);
+    s.key = key;
+    s.best_output.assign(1 << 16, 0);
+    s.best_count.assign(1 << 16, 0);
+    s.outputs.assign(1 << 16, 0);
+    // 256 input differences per task
+    tables::run(pool, 256, [&](size_t task) {
+        std::vector<uint32_t> counts(1 << 16);
+        for (uint32_t a = 256 * task; a < 256 * (task + 1); a++)
+        {
+            superbox64_ddt_row(values, static_cast<uint16_t>(a), counts.data());
+            uint32_t best = 0, nonzero = 0;
+            for (uint32_t b = 0; b < (1 << 16); b++)
+            {
+                nonzero += counts[b] != 0;
+                if (counts[b] > counts[best])
+                    best = b;
+            }
+            s.best_output[a] = best;
+            s.best_count[a] = counts[best];
+            s.outputs[a] = nonzero;
+        }
+    });
+    return s;
+}
+
+inline std::string superbox64_path(const std::string &dir, uint16_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%04x", key);
+    return dir + "/skinny-superbox64-" + name + ".tbl";
+}
+
+// The key is in the file name (and its low byte in the S-box field of the header)
+// *saved as for cached_table()
+inline SuperboxSummary cached_superbox64_summary(uint16_t key, const std::string &dir = ".", WorkStealingPool *pool = NULL,
+                                                 bool *saved = NULL)
+{
+    const std::string path = superbox64_path(dir, key);
+    std::vector<uint8_t> bytes;
+    SuperboxSummary s;
+    std::vector<uint32_t> *columns[3] = {&s.best_output, &s.best_count, &s.outputs};
+    if (tables::load_entries(path, TABLE_SUPERBOX64, static_cast<uint8_t>(key), 4, 1 << 16, 3, bytes))
+    {
+        s.key = key;
+        for (int c = 0; c < 3; c++)
+            columns[c]->assign(1 << 16, 0);
+        for (uint32_t a = 0; a < (1 << 16); a++)
+            for (int c = 0; c < 3; c++)
+                (*columns[c])[a] = tables::get32(&bytes[4 * (3 * a + c)]);
+        if (saved != NULL)
+            *saved = true;
+        return s;
+    }
+    s = superbox64_summary(key, pool);
+    bytes.assign(12 << 16, 0);
+    for (uint32_t a = 0; a < (1 << 16); a++)
+        for (int c = 0; c < 3; c++)
+            tables::put32(&bytes[4 * (3 * a + c)], (*columns[c])[a]);
+    bool stored = tables::save_entries(path, TABLE_SUPERBOX64, static_cast<uint8_t>(key), 4, 1 << 16, 3, bytes);
+    if (saved != NULL)
+        *saved = stored;
+    return s;
+}
+
+} // namespace skinny
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * SKINNY-AEAD M1/M2 (ThetaCB3 on Skinny-128-384)
+ * Date: Oct 17, 2026
+*/
+//Skinny-128-384: 56 rounds
+// Usage: skinny-aead.o [-1|-2 KAT_FILE]
+// Without arguments, checks both members against a block-by-block reference, round trips,
+// forged tags, the pool, that M1 and M2 never share an output, and the records of the
+// official vectors embedded below. With -1 / -2, checks
+// M1 / M2 against LWC_AEAD_KAT_128_128.txt / LWC_AEAD_KAT_128_96.txt of the
+// SKINNY-AEAD submission package.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "lwc_kat.h"
+#include "skinny_aead.h"
+
+using namespace std;
+using namespace skinny;
+
+typedef Skinny128_384 Cipher;
+
+void print_bytes(const uint8_t *bytes, size_t len);
+size_t reference_encrypt(SkinnyAead::Member member, const uint8_t key[16], const uint8_t *nonce, const uint8_t *ad, size_t adlen,
+                         const uint8_t *m, size_t mlen, uint8_t *c);
+int check_kat(SkinnyAead::Member member, FILE *f, const char *label);
+
+// Records of the SKINNY-AEAD package pasted verbatim, M1 from LWC_AEAD_KAT_128_128.txt and
+// M2 from LWC_AEAD_KAT_128_96.txt: empty AD and PT, partial PT and AD blocks, AD and PT of
+// several blocks. They pin the member bits, the tweak layout and the tag index that the
+// block-by-block reference could only restate. Empty: none embedded yet.
+static const char M1_KAT[] = "";
+static const char M2_KAT[] = "";
+
+void print_bytes(const uint8_t *bytes, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        printf("%02x", bytes[i]);
+    printf("\n");
+}
+
+// Straightforward SKINNY-AEAD: the LFSR clocked block by block (the pad of a partial last
+// message block counts as a block), one tweakey schedule and enc() per block, the nonce
+// in TK2 throughout
+size_t reference_encrypt(SkinnyAead::Member member, const uint8_t key[16], const uint8_t *nonce, const uint8_t *ad, size_t adlen,
+                         const uint8_t *m, size_t mlen, uint8_t *c)
+{
+    const int R = Cipher::ROUNDS;
+    const uint8_t prefix = (member == SkinnyAead::M1) ? 0x00 : 0x10;
+    uint8_t tk[3][16], rtk[R][8], block[16], out[16], checksum[16] = {0}, auth[16] = {0};
+    uint64_t lfsr = 1;
+    auto tbc = [&](uint8_t domain) {
+        SkinnyAead::compose_tk1(lfsr, prefix | domain, tk[0]);
+        memset(tk[1], 0, 16);
+        memcpy(tk[1], nonce, (member == SkinnyAead::M1) ? 16 : 12);
+        memcpy(tk[2], key, 16);
+        Cipher::tweakey_schedule(R, tk, rtk);
+        Cipher::enc(R, block, out, rtk);
+    };
+    size_t i = 0;
+    for (; i + 16 <= mlen; i += 16, lfsr = SkinnyAead::clock_lfsr(lfsr))
+    {
+        memcpy(block, m + i, 16);
+        tbc(0);
+        memcpy(c + i, out, 16);
+        for (uint8_t k = 0; k < 16; k++)
+            checksum[k] ^= m[i + k];
+    }
+    uint8_t final_domain = 4;
+    if (i < mlen)
+    {
+        memset(block, 0, 16);
+        tbc(1);
+        for (size_t k = 0; k < mlen - i; k++)
+        {
+            c[i + k] = m[i + k] ^ out[k];
+            checksum[k] ^= m[i + k];
+        }
+        checksum[mlen - i] ^= 0x80;
+        lfsr = SkinnyAead::clock_lfsr(lfsr);
+        final_domain = 5;
+    }
+    memcpy(block, checksum, 16);
+    tbc(final_domain);
+    memcpy(c + mlen, out, 16);
+    lfsr = 1;
+    for (i = 0; i < adlen; i += 16, lfsr = SkinnyAead::clock_lfsr(lfsr))
+    {
+        memset(block, 0, 16);
+        if (i + 16 <= adlen)
+            memcpy(block, ad + i, 16);
+        else
+        {
+            memcpy(block, ad + i, adlen - i);
+            block[adlen - i] = 0x80;
+        }
+        tbc((i + 16 <= adlen) ? 2 : 3);
+        for (uint8_t k = 0; k < 16; k++)
+            auth[k] ^= out[k];
+    }
+    for (uint8_t k = 0; k < 16; k++)
+        c[mlen + k] ^= auth[k];
+    return mlen + 16;
+}
+
+// Every record of an LWC AEAD KAT file (closed here): encryption gives CT (ciphertext ||
+// tag), and decryption of CT gives PT back
+int check_kat(SkinnyAead::Member member, FILE *f, const char *label)
+{
+    kat::Record record;
+    size_t records = 0, mismatches = 0;
+    while (kat::read_record(f, record))
+    {
+        const vector<uint8_t> &key = record["Key"], &nonce = record["Nonce"], &pt = record["PT"], &ad = record["AD"],
+                              &ct = record["CT"];
+        records++;
+        if (key.size() != 16 || nonce.size() != ((member == SkinnyAead::M1) ? 16u : 12u) || ct.size() != pt.size() + 16)
+        {
+            printf("record %s: malformed\n", kat::count(record).c_str());
+            mismatches++;
+            continue;
+        }
+        SkinnyAead aead(key.data(), member);
+        vector<uint8_t> c(pt.size() + 16), m(pt.size() + 1);
+        aead.encrypt(nonce.data(), ad.data(), ad.size(), pt.data(), pt.size(), c.data());
+        bool valid = aead.decrypt(nonce.data(), ad.data(), ad.size(), ct.data(), ct.size(), m.data());
+        if (c != ct || !valid || memcmp(m.data(), pt.data(), pt.size()) != 0)
+        {
+            printf("record %s: failed\n", kat::count(record).c_str());
+            mismatches++;
+        }
+    }
+    fclose(f);
+    printf("%-30s%s (%zu records)\n", label, (records > 0 && mismatches == 0) ? "passed" : "failed", records);
+    return (records > 0 && mismatches == 0) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 3 && (strcmp(argv[1], "-1") == 0 || strcmp(argv[1], "-2") == 0))
+    {
+        FILE *f = fopen(argv[2], "r");
+        if (f == NULL)
+        {
+            fprintf(stderr, "skinny-aead: cannot open %s\n", argv[2]);
+            return 2;
+        }
+        bool m1 = (argv[1][1] == '1');
+        return check_kat(m1 ? SkinnyAead::M1 : SkinnyAead::M2, f, m1 ? "m1 kat:" : "m2 kat:");
+    }
+    if (argc != 1)
+    {
+        fprintf(stderr, "usage: %s [-1|-2 KAT_FILE]\n", argv[0]);
+        return 2;
+    }
+    const size_t lengths[] = {0, 1, 15, 16, 17, 31, 32, 33, 48, 100};
+    const int count = sizeof(lengths) / sizeof(lengths[0]);
+    uint8_t key[16], nonce[16];
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        key[i] = i;
+        nonce[i] = static_cast<uint8_t>(0xf0 ^ i);
+    }
+    // More than two chunks of message and more than one of associated data
+    const size_t big_m = 2 * SkinnyAead::CHUNK_BLOCKS * 16 + 1000 * 16 + 5, big_ad = SkinnyAead::CHUNK_BLOCKS * 16 + 7;
+    vector<uint8_t> msg(big_m), ad(big_ad), c(big_m + 16), c_ref(big_m + 16), m(big_m);
+    for (size_t i = 0; i < big_m; i++)
+        msg[i] = static_cast<uint8_t>(5 * i + 2);
+    for (size_t i = 0; i < big_ad; i++)
+        ad[i] = static_cast<uint8_t>(3 * i + 1);
+    printf("%-30s", "key:");
+    print_bytes(key, 16);
+    printf("%-30s", "nonce:");
+    print_bytes(nonce, 16);
+    printf("%-30s", "ad / message:");
+    print_bytes(ad.data(), 16);
+    printf("%-30s", "");
+    print_bytes(msg.data(), 20);
+    WorkStealingPool pool(4);
+    bool all_passed = true;
+    for (int member = 0; member < 2; member++)
+    {
+        SkinnyAead aead(key, static_cast<SkinnyAead::Member>(member));
+        aead.encrypt(nonce, ad.data(), 16, msg.data(), 20, c.data());
+        printf("%-30s", member == 0 ? "m1 ciphertext || tag:" : "m2 ciphertext || tag:");
+        print_bytes(c.data(), 36);
+        // Round trip and a forged tag, serial and on the pool, against the reference
+        bool passed = true;
+        for (int a = 0; a < count; a++)
+            for (int b = 0; b < count; b++)
+            {
+                size_t adlen = lengths[a], mlen = lengths[b];
+                size_t clen = aead.encrypt(nonce, ad.data(), adlen, msg.data(), mlen, c.data());
+                reference_encrypt(aead.nonce_bytes() == 16 ? SkinnyAead::M1 : SkinnyAead::M2, key, nonce, ad.data(), adlen, msg.data(), mlen, c_ref.data());
+                bool valid = aead.decrypt(nonce, ad.data(), adlen, c.data(), clen, m.data());
+                if (clen != mlen + 16 || !valid || memcmp(m.data(), msg.data(), mlen) != 0 || memcmp(c.data(), c_ref.data(), clen) != 0)
+                    passed = false;
+                c[clen - 1] ^= 0x80;
+                if (aead.decrypt(nonce, ad.data(), adlen, c.data(), clen, m.data(), pool))
+                    passed = false;
+            }
+        printf("%-30s", member == 0 ? "m1:" : "m2:");
+        printf("%s\n", passed ? "passed" : "failed");
+        all_passed &= passed;
+        // Several chunks: 4 threads == serial == reference
+        size_t clen = aead.encrypt(nonce, ad.data(), big_ad, msg.data(), big_m, c.data(), pool);
+        bool pooled_passed = (clen == big_m + 16);
+        reference_encrypt(static_cast<SkinnyAead::Member>(member), key, nonce, ad.data(), big_ad, msg.data(), big_m, c_ref.data());
+        if (memcmp(c.data(), c_ref.data(), clen) != 0)
+            pooled_passed = false;
+        aead.encrypt(nonce, ad.data(), big_ad, msg.data(), big_m, c_ref.data());
+        if (memcmp(c.data(), c_ref.data(), clen) != 0)
+            pooled_passed = false;
+        if (!aead.decrypt(nonce, ad.data(), big_ad, c.data(), clen, m.data(), pool) || m != msg)
+            pooled_passed = false;
+        printf("%-30s", "bulk (4 threads):");
+        printf("%s\n", pooled_passed ? "passed" : "failed");
+        all_passed &= pooled_passed;
+    }
+    // Domain separation: M2 under nonce N against M1 under N || 0^32, which puts the same TK2
+    SkinnyAead m1(key, SkinnyAead::M1), m2(key, SkinnyAead::M2);
+    uint8_t padded_nonce[16] = {0};
+    memcpy(padded_nonce, nonce, 12);
+    bool separated = true;
+    for (int a = 0; a < count; a++)
+        for (int b = 0; b < count; b++)
+        {
+            size_t adlen = lengths[a], mlen = lengths[b];
+            m1.encrypt(padded_nonce, ad.data(), adlen, msg.data(), mlen, c.data());
+            m2.encrypt(nonce, ad.data(), adlen, msg.data(), mlen, c_ref.data());
+            if (memcmp(c.data() + mlen, c_ref.data() + mlen, 16) == 0 || (mlen > 0 && memcmp(c.data(), c_ref.data(), mlen) == 0))
+                separated = false;
+            if (m1.decrypt(padded_nonce, ad.data(), adlen, c_ref.data(), mlen + 16, m.data()))
+                separated = false;
+        }
+    printf("%-30s", "m1 / m2 separated:");
+    printf("%s\n", separated ? "passed" : "failed");
+    all_passed &= separated;
+    // The official records pasted above
+    for (SkinnyAead::Member member : {SkinnyAead::M1, SkinnyAead::M2})
+    {
+        const char *label = (member == SkinnyAead::M1) ? "m1 kat records:" : "m2 kat records:";
+        FILE *f = kat::open_text((member == SkinnyAead::M1) ? M1_KAT : M2_KAT);
+        if (f == NULL)
+            printf("%-30s%s\n", label, "none embedded");
+        else
+            all_passed &= check_kat(member, f, label) == 0;
+    }
+    printf("Press Enter to exit ...\n");
+    getchar();
+    return all_passed ? 0 : 1;
+}
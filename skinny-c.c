@@ -0,0 +1,162 @@
+/*
+ * C program against libskinny (skinny_c.h)
+ * Date: Oct 18, 2026
+*/
+// Built as C99 and linked against libskinny.a: the test vectors of the four variants
+// through single blocks, batches against single blocks, multi-key batches against one key
+// per block, four threads on one key at once, and the error codes.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "skinny_c.h"
+
+#define BATCH 1000
+#define THREADS 4
+
+struct vector
+{
+    skinny_variant variant;
+    const char *name, *tweakey, *plaintext, *ciphertext;
+};
+
+// The test vectors of the README, TK1 || TK2 || TK3
+static const struct vector VECTORS[4] = {
+    {SKINNY_64_128, "skinny-64-128", "d70fd8c5735f8264c2c7a48ccb456a3c", "14ca5472ebae80c7", "01398221bd577c31"},
+    {SKINNY_64_192, "skinny-64-192", "bebea20a052cc18bb23b936a8045a680399816adb6c979cc", "16bb1e8a3477e654", "9033c0d31432637d"},
+    {SKINNY_128_256, "skinny-128-256", "c683dc9e0ad25edf7d6300367d4b86657926f29ea97cf5d67a08d6446cb7ce32",
+     "e82da08d25828a562dfd13ffca64e18a", "8a7fa5c2f46472123f28c639cfa00824"},
+    {SKINNY_128_384, "skinny-128-384",
+     "b372cdd48ca7d309d10f2fb2e6f5fe2a365b015aac7bfd8f4b06b919864c3839be050e4bade1547ef08330d6792e01af",
+     "44405dd624507aa3e3d0092ace7f931f", "4b25c67cf6f5d9dca8d718120fe3903c"}};
+
+struct job
+{
+    const skinny_key *key;
+    const uint8_t *plaintext, *expected;
+    int passed;
+};
+
+// Hex digits to cells, one digit per cell for 4-bit cells and two for 8-bit cells
+static void parse_cells(const char *hex, int cell_bits, uint8_t *cells)
+{
+    size_t digits = (cell_bits == 4) ? 1 : 2;
+    size_t n = strlen(hex) / digits;
+    for (size_t i = 0; i < n; i++)
+    {
+        char digit[3] = {0, 0, 0};
+        memcpy(digit, hex + digits * i, digits);
+        cells[i] = (uint8_t)strtoul(digit, NULL, 16);
+    }
+}
+
+static void *encrypt_many(void *arg)
+{
+    struct job *job = (struct job *)arg;
+    uint8_t out[BATCH * 16];
+    job->passed = 1;
+    for (int n = 0; n < 20; n++)
+    {
+        if (skinny_encrypt(job->key, job->plaintext, out, BATCH) != SKINNY_OK || memcmp(out, job->expected, sizeof(out)) != 0)
+            job->passed = 0;
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    static uint8_t plaintext[BATCH * 16], ciphertext[BATCH * 16], decrypted[BATCH * 16], single[BATCH * 16];
+    static uint8_t tweakeys[BATCH * 3 * 16];
+    int all_passed = 1;
+    printf("%-30s%d\n", "ABI version:", skinny_abi_version());
+    for (int v = 0; v < 4; v++)
+    {
+        const struct vector *t = &VECTORS[v];
+        skinny_kernel_info info;
+        uint8_t tweakey[3 * 16], pt[16], ct[16], expected[16];
+        int passed;
+        skinny_kernel_info_get(t->variant, &info);
+        int cell_bits = info.block_bits / 16, mask = (1 << cell_bits) - 1;
+        printf("%-30s%d-bit block, %d rounds, %s\n", t->name, info.block_bits, info.rounds, info.kernel);
+        parse_cells(t->tweakey, cell_bits, tweakey);
+        parse_cells(t->plaintext, cell_bits, pt);
+        parse_cells(t->ciphertext, cell_bits, expected);
+        skinny_key *key;
+        if (skinny_key_create(t->variant, tweakey, &key) != SKINNY_OK)
+            return 1;
+
+        // Test vector through one block
+        skinny_encrypt_block(key, pt, ct);
+        passed = memcmp(ct, expected, 16) == 0;
+        skinny_decrypt_block(key, pt, ct);
+        parse_cells(t->plaintext, cell_bits, expected);
+        passed &= memcmp(pt, expected, 16) == 0 && skinny_key_variant(key) == t->variant;
+        printf("%-30s%s\n", "  test vector:", passed ? "passed" : "failed");
+        all_passed &= passed;
+
+        // A batch against single blocks
+        for (size_t j = 0; j < BATCH; j++)
+            for (int i = 0; i < 16; i++)
+                plaintext[16 * j + i] = (uint8_t)((pt[i] + j * (i + 1)) & mask);
+        for (size_t j = 0; j < BATCH; j++)
+            skinny_encrypt_block(key, plaintext + 16 * j, single + 16 * j);
+        passed = skinny_encrypt(key, plaintext, ciphertext, BATCH) == SKINNY_OK && memcmp(ciphertext, single, sizeof(single)) == 0;
+        passed &= skinny_decrypt(key, decrypted, ciphertext, BATCH) == SKINNY_OK && memcmp(decrypted, plaintext, sizeof(plaintext)) == 0;
+        printf("%-30s%s\n", "  batch:", passed ? "passed" : "failed");
+        all_passed &= passed;
+
+        // Every block under its own key
+        passed = 1;
+        for (size_t j = 0; j < BATCH; j++)
+            for (int i = 0; i < 16 * info.lanes; i++)
+                tweakeys[16 * info.lanes * j + i] = (uint8_t)((tweakey[i] + j * (i + 3)) & mask);
+        passed &= skinny_encrypt_multikey(t->variant, tweakeys, plaintext, ciphertext, BATCH) == SKINNY_OK;
+        passed &= skinny_decrypt_multikey(t->variant, tweakeys, decrypted, ciphertext, BATCH) == SKINNY_OK;
+        for (size_t j = 0; j < BATCH; j += 37)
+        {
+            skinny_key *block_key = skinny_key_new(t->variant, tweakeys + 16 * info.lanes * j);
+            skinny_encrypt_block(block_key, plaintext + 16 * j, ct);
+            passed &= memcmp(ct, ciphertext + 16 * j, 16) == 0;
+            skinny_key_free(block_key);
+        }
+        passed &= memcmp(decrypted, plaintext, sizeof(plaintext)) == 0;
+        printf("%-30s%s\n", "  multi-key:", passed ? "passed" : "failed");
+        all_passed &= passed;
+
+        // One key shared by several threads
+        pthread_t threads[THREADS];
+        struct job jobs[THREADS];
+        passed = 1;
+        for (int n = 0; n < THREADS; n++)
+        {
+            jobs[n].key = key;
+            jobs[n].plaintext = plaintext;
+            jobs[n].expected = single;
+            pthread_create(&threads[n], NULL, encrypt_many, &jobs[n]);
+        }
+        for (int n = 0; n < THREADS; n++)
+        {
+            pthread_join(threads[n], NULL);
+            passed &= jobs[n].passed;
+        }
+        printf("%-30s%s\n", "  threads:", passed ? "passed" : "failed");
+        all_passed &= passed;
+        skinny_key_free(key);
+    }
+
+    // Bad arguments are reported, not crashed on
+    skinny_key *bad = (skinny_key *)plaintext;
+    int passed = skinny_key_create((skinny_variant)7, plaintext, &bad) == SKINNY_ERROR_VARIANT && bad == NULL &&
+                 skinny_key_create(SKINNY_128_256, NULL, &bad) == SKINNY_ERROR_ARGUMENT &&
+                 skinny_key_create(SKINNY_128_256, tweakeys, NULL) == SKINNY_ERROR_ARGUMENT && skinny_key_variant(NULL) == SKINNY_ERROR_ARGUMENT &&
+                 skinny_key_new((skinny_variant)7, plaintext) == NULL &&
+                 skinny_key_new(SKINNY_64_128, NULL) == NULL && skinny_encrypt_block(NULL, plaintext, ciphertext) == SKINNY_ERROR_ARGUMENT &&
+                 skinny_encrypt_multikey((skinny_variant)7, tweakeys, plaintext, ciphertext, 1) == SKINNY_ERROR_VARIANT &&
+                 skinny_kernel_info_get(SKINNY_64_128, NULL) == SKINNY_ERROR_ARGUMENT && strcmp(skinny_strerror(SKINNY_ERROR_MEMORY), "out of memory") == 0;
+    skinny_key_free(NULL);
+    printf("%-30s%s\n", "errors:", passed ? "passed" : "failed");
+    all_passed &= passed;
+    return all_passed ? 0 : 1;
+}
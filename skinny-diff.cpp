@@ -0,0 +1,188 @@
+/*
+ * skinny-diff: probability of a differential over reduced-round Skinny
+ * Date: Oct 17, 2026
+*/
+// Usage: skinny-diff.o -c CIPHER -r ROUNDS -i INPUT_DIFF -o OUTPUT_DIFF [-k TWEAKEY_DIFF]
+//                      [-n SAMPLES | -l LOG2_SAMPLES] [-t THREADS] [-s SEED] [-z Z]
+// CIPHER is skinny-64-128, skinny-64-192, skinny-128-256 or skinny-128-384. Differences are
+// hex cells, one digit per cell for Skinny-64 and two for Skinny-128; TWEAKEY_DIFF holds all
+// tweakey lanes (zero by default). SAMPLES defaults to 2^24, Z (the width of the confidence
+// interval in standard deviations) to 1.96. Progress goes to stderr.
+// Example: skinny-diff.o -c skinny-64-128 -r 1 -i 1000000000000000 -o 9000900000009000 -l 20
+// Without arguments, checks that this 1-round differential of probability 2^-2 falls in
+// its interval, that a zero output difference never follows a nonzero input difference
+// in one round, and that the matches for a seed do not depend on the number of threads.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <chrono>
+#include <string>
+#include "skinny_differential.h"
+
+using namespace std;
+using namespace skinny;
+
+struct Args
+{
+    string cipher, input, output, tweakey;
+    int rounds = 0;
+    uint64_t samples = 1 << 24;
+    unsigned threads = 0;
+    uint64_t seed = 1;
+    double z = 1.959964;
+};
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s -c skinny-64-128|skinny-64-192|skinny-128-256|skinny-128-384 -r ROUNDS -i INPUT_DIFF -o OUTPUT_DIFF\n"
+                    "       [-k TWEAKEY_DIFF] [-n SAMPLES | -l LOG2_SAMPLES] [-t THREADS] [-s SEED] [-z Z]\n",
+            name);
+}
+
+// cells hex cells of cell_bits bits each, cell_bits / 4 digits per cell
+static bool parse_cells(const string &hex, int cell_bits, size_t cells, uint8_t *out)
+{
+    size_t digits = cell_bits / 4;
+    if (hex.size() != cells * digits)
+        return false;
+    for (size_t i = 0; i < hex.size(); i++)
+        if (!isxdigit(static_cast<unsigned char>(hex[i])))
+            return false;
+    for (size_t i = 0; i < cells; i++)
+        out[i] = static_cast<uint8_t>(stoul(hex.substr(i * digits, digits), 0, 16));
+    return true;
+}
+
+template <class Cipher>
+static int run(const Args &args)
+{
+    Differential d;
+    memset(&d, 0, sizeof(d));
+    d.rounds = args.rounds;
+    if (args.rounds < 1 || args.rounds > Cipher::ROUNDS)
+    {
+        fprintf(stderr, "%s: 1 to %d rounds\n", args.cipher.c_str(), Cipher::ROUNDS);
+        return 1;
+    }
+    if (!parse_cells(args.input, Cipher::CELL_BITS, 16, d.input) || !parse_cells(args.output, Cipher::CELL_BITS, 16, d.output) ||
+        (!args.tweakey.empty() && !parse_cells(args.tweakey, Cipher::CELL_BITS, 16 * Cipher::LANES, d.tweakey[0])))
+    {
+        fprintf(stderr, "%s: differences are 16 cells (the tweakey %d lane(s) of 16 cells) of %d bits in hex\n", args.cipher.c_str(),
+                Cipher::LANES, Cipher::CELL_BITS);
+        return 1;
+    }
+    WorkStealingPool pool(args.threads);
+    typedef chrono::steady_clock clock;
+    clock::time_point start = clock::now(), shown = start;
+    DifferentialEstimate e = estimate_differential<Cipher>(d, args.samples, args.seed, pool, args.z, [&](uint64_t done, uint64_t matches) {
+        if (clock::now() - shown < chrono::milliseconds(500) && done < args.samples)
+            return;
+        shown = clock::now();
+        fprintf(stderr, "\r%6.2f %%  %llu / %llu pairs, %llu matches", 100.0 * done / args.samples, (unsigned long long)done,
+                (unsigned long long)args.samples, (unsigned long long)matches);
+    });
+    double seconds = chrono::duration<double>(clock::now() - start).count();
+    fprintf(stderr, "\n");
+    printf("%-30s%s, %d rounds, %s kernels, %u threads\n", "cipher:", args.cipher.c_str(), args.rounds, select_kernels<Cipher>().name,
+           pool.threads());
+    printf("%-30s%s -> %s\n", "differential:", args.input.c_str(), args.output.c_str());
+    if (!args.tweakey.empty())
+        printf("%-30s%s\n", "tweakey difference:", args.tweakey.c_str());
+    printf("%-30s%llu / %llu\n", "matches / pairs:", (unsigned long long)e.matches, (unsigned long long)e.samples);
+    printf("%-30s%.6g (2^%.2f)\n", "probability:", e.probability, e.log2_probability);
+    printf("%-30s[%.6g, %.6g] (2^%.2f, 2^%.2f), z = %.3f\n", "confidence interval:", e.lower, e.upper, log2(e.lower), log2(e.upper), args.z);
+    printf("%-30s%.2f s, %.3g pairs/s\n", "time:", seconds, e.samples / seconds);
+    return 0;
+}
+
+static int check()
+{
+    Differential d;
+    memset(&d, 0, sizeof(d));
+    d.rounds = 1;
+    d.input[0] = 0x1;
+    d.output[0] = d.output[4] = d.output[12] = 0x9;
+    const uint64_t samples = 1 << 20, seed = 2026;
+    WorkStealingPool pool;
+    DifferentialEstimate e = estimate_differential<Skinny64_128>(d, samples, seed, pool);
+    bool probability_passed = e.samples == samples && e.lower <= 0.25 && 0.25 <= e.upper;
+    printf("%-30s%s\n", "1-round differential 2^-2:", probability_passed ? "passed" : "failed");
+
+    Differential impossible = d;
+    memset(impossible.output, 0, 16);
+    bool impossible_passed = estimate_differential<Skinny64_128>(impossible, samples, seed, pool).matches == 0;
+    printf("%-30s%s\n", "impossible differential:", impossible_passed ? "passed" : "failed");
+
+    // 1, 2, 3 and 8 threads against the default pool, over 16 tasks and over a single
+    // partial task
+    bool threads_passed = true;
+    for (unsigned threads : {1u, 2u, 3u, 8u})
+    {
+        WorkStealingPool other(threads);
+        threads_passed &= estimate_differential<Skinny64_128>(d, samples, seed, other).matches == e.matches;
+        threads_passed &= estimate_differential<Skinny64_128>(d, 5000, seed, other).matches ==
+                          estimate_differential<Skinny64_128>(d, 5000, seed, pool).matches;
+    }
+    printf("%-30s%s\n", "independent of threads:", threads_passed ? "passed" : "failed");
+    return (probability_passed && impossible_passed && threads_passed) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 1)
+        return check();
+    Args args;
+    for (int i = 1; i < argc; i++)
+    {
+        string opt = argv[i];
+        if (i + 1 >= argc)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        const char *value = argv[++i];
+        if (opt == "-c")
+            args.cipher = value;
+        else if (opt == "-r")
+            args.rounds = atoi(value);
+        else if (opt == "-i")
+            args.input = value;
+        else if (opt == "-o")
+            args.output = value;
+        else if (opt == "-k")
+            args.tweakey = value;
+        else if (opt == "-n")
+            args.samples = strtoull(value, NULL, 0);
+        else if (opt == "-l")
+            args.samples = 1ULL << min(62, max(0, atoi(value)));
+        else if (opt == "-t")
+            args.threads = static_cast<unsigned>(atoi(value));
+        else if (opt == "-s")
+            args.seed = strtoull(value, NULL, 0);
+        else if (opt == "-z")
+            args.z = atof(value);
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (args.samples == 0)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    if (args.cipher == "skinny-64-128")
+        return run<Skinny64_128>(args);
+    if (args.cipher == "skinny-64-192")
+        return run<Skinny64_192>(args);
+    if (args.cipher == "skinny-128-256")
+        return run<Skinny128_256>(args);
+    if (args.cipher == "skinny-128-384")
+        return run<Skinny128_384>(args);
+    usage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,679 @@
+/*
+ * skinny-file: file encryption with the Skinny batch kernels
+ * Date: Oct 17, 2026
+*/
+// Usage: skinny-file.o -e|-d -k KEY -n NONCE [-m ctr|aead] [-c CIPHER] [--tk1] [-a AD]
+//                      [-t THREADS] [-i INPUT] [-o OUTPUT]
+// - ctr (default): Ctr<Cipher> with CIPHER one of skinny-64-128, skinny-64-192,
+//   skinny-128-256, skinny-128-384 (default). KEY is the LANES tweakey lanes (LANES - 1
+//   with --tk1, where the block counter is TK1) and NONCE one block, as hex cells: one
+//   digit per cell for Skinny-64, two for Skinny-128. Encryption and decryption are the same.
+// - aead: SKINNY-AEAD, KEY of 16 bytes, NONCE of 16 (M1) or 12 bytes (M2), optional
+//   associated data AD; encryption appends the 16-byte tag, decryption checks and strips it.
+// INPUT and OUTPUT default to stdin / stdout ("-"). A regular input file with a file output
+// is memory-mapped, the output is preallocated and mapped too, and the kernels read from
+// one mapping and write into the other, without intermediate copies. AEAD decryption maps a
+// private temporary file next to OUTPUT instead, renamed to OUTPUT only once the tag has
+// been checked, so no reader of OUTPUT ever sees unauthenticated plaintext. Otherwise CTR streams
+// through two buffers (the next one is read while the current one is encrypted), while
+// AEAD reads the whole input first: the tag covers all of it, and OUTPUT is only opened
+// once the tag has been checked. A failed tag check exits with status 2 and leaves OUTPUT
+// as it was.
+// Without arguments, round-trips temporary files through -e / -d, mapped and streamed
+// (through a FIFO): CTR with every variant with and without --tk1, AEAD M1 and M2; checks
+// that a tampered ciphertext is rejected with OUTPUT untouched and that -t needs a
+// positive count.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <ctype.h>
+#include <signal.h>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "skinny_ctr.h"
+#include "skinny_aead.h"
+#include "xoshiro256.h"
+
+using namespace std;
+using namespace skinny;
+
+struct Args
+{
+    bool decrypt = false;
+    bool tk1 = false;
+    unsigned threads = 0;
+    string mode = "ctr", cipher = "skinny-128-384";
+    string key, nonce, ad, input = "-", output = "-";
+};
+
+// in -> out (same buffer or disjoint); bytes of the output, or -1 if the tag does not match
+typedef function<ssize_t(const uint8_t *in, size_t bytes, uint8_t *out)> Process;
+
+static const size_t STREAM_BUFFER = 1 << 20;
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s -e|-d -k KEY -n NONCE [-m ctr|aead] [-c skinny-64-128|skinny-64-192|skinny-128-256|skinny-128-384]\n"
+                    "       [--tk1] [-a AD] [-t THREADS] [-i INPUT] [-o OUTPUT]\n",
+            name);
+}
+
+// cells hex cells of cell_bits bits each, cell_bits / 4 digits per cell
+static bool parse_cells(const string &hex, int cell_bits, size_t cells, uint8_t *out)
+{
+    size_t digits = cell_bits / 4;
+    if (hex.size() != cells * digits)
+        return false;
+    for (size_t i = 0; i < hex.size(); i++)
+        if (!isxdigit(static_cast<unsigned char>(hex[i])))
+            return false;
+    for (size_t i = 0; i < cells; i++)
+        out[i] = static_cast<uint8_t>(stoul(hex.substr(i * digits, digits), 0, 16));
+    return true;
+}
+
+static ssize_t read_full(int fd, uint8_t *buffer, size_t size)
+{
+    size_t got = 0;
+    while (got < size)
+    {
+        ssize_t n = read(fd, buffer + got, size - got);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            return -1;
+        if (n == 0)
+            break;
+        got += n;
+    }
+    return static_cast<ssize_t>(got);
+}
+
+static bool write_full(int fd, const uint8_t *buffer, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t n = write(fd, buffer, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        buffer += n;
+        size -= n;
+    }
+    return true;
+}
+
+template <class Cipher>
+static bool make_ctr(const Args &args, WorkStealingPool &pool, Process &process)
+{
+    const int lanes = Cipher::LANES - (args.tk1 ? 1 : 0);
+    uint8_t tweakey[3][16] = {{0}}, nonce[16];
+    if (lanes < 1 || !parse_cells(args.key, Cipher::CELL_BITS, 16 * lanes, tweakey[args.tk1 ? 1 : 0]))
+    {
+        fprintf(stderr, "%s: the key is %d lane(s) of 16 cells of %d bits in hex\n", args.cipher.c_str(), lanes, Cipher::CELL_BITS);
+        return false;
+    }
+    if (!parse_cells(args.nonce, Cipher::CELL_BITS, 16, nonce))
+    {
+        fprintf(stderr, "%s: the nonce is 16 cells of %d bits in hex\n", args.cipher.c_str(), Cipher::CELL_BITS);
+        return false;
+    }
+    shared_ptr<Ctr<Cipher>> ctr = make_shared<Ctr<Cipher>>(tweakey, nonce, args.tk1 ? COUNTER_IN_TK1 : COUNTER_IN_BLOCK);
+    // Called on consecutive pieces of the stream: the first block of the next piece follows on
+    shared_ptr<uint64_t> block = make_shared<uint64_t>(0);
+    process = [ctr, block, &pool](const uint8_t *in, size_t bytes, uint8_t *out) -> ssize_t {
+        ctr->crypt(in, out, bytes, *block, pool);
+        *block += bytes / Ctr<Cipher>::BLOCK_BYTES;
+        return static_cast<ssize_t>(bytes);
+    };
+    return true;
+}
+
+static bool make_aead(const Args &args, WorkStealingPool &pool, Process &process)
+{
+    uint8_t key[16], nonce[16] = {0};
+    if (!parse_cells(args.key, 8, 16, key))
+    {
+        fprintf(stderr, "aead: the key is 16 bytes in hex\n");
+        return false;
+    }
+    bool m1 = parse_cells(args.nonce, 8, 16, nonce);
+    if (!m1 && !parse_cells(args.nonce, 8, 12, nonce))
+    {
+        fprintf(stderr, "aead: the nonce is 16 (M1) or 12 bytes (M2) in hex\n");
+        return false;
+    }
+    shared_ptr<vector<uint8_t>> ad = make_shared<vector<uint8_t>>(args.ad.size() / 2);
+    if (args.ad.size() % 2 != 0 || !parse_cells(args.ad, 8, ad->size(), ad->data()))
+    {
+        fprintf(stderr, "aead: the associated data is given in hex\n");
+        return false;
+    }
+    shared_ptr<SkinnyAead> aead = make_shared<SkinnyAead>(key, m1 ? SkinnyAead::M1 : SkinnyAead::M2);
+    vector<uint8_t> n(nonce, nonce + 16);
+    bool decrypt = args.decrypt;
+    process = [aead, ad, n, decrypt, &pool](const uint8_t *in, size_t bytes, uint8_t *out) -> ssize_t {
+        if (!decrypt)
+            return static_cast<ssize_t>(aead->encrypt(n.data(), ad->data(), ad->size(), in, bytes, out, pool));
+        if (!aead->decrypt(n.data(), ad->data(), ad->size(), in, bytes, out, pool))
+            return -1;
+        return static_cast<ssize_t>(bytes - SkinnyAead::TAG_BYTES);
+    };
+    return true;
+}
+
+// Output size for an input of the given size, or -1 if the input cannot be valid
+static ssize_t output_size(const Args &args, size_t in_size)
+{
+    if (args.mode == "ctr")
+        return static_cast<ssize_t>(in_size);
+    if (!args.decrypt)
+        return static_cast<ssize_t>(in_size + SkinnyAead::TAG_BYTES);
+    return (in_size < static_cast<size_t>(SkinnyAead::TAG_BYTES)) ? -1 : static_cast<ssize_t>(in_size - SkinnyAead::TAG_BYTES);
+}
+
+// Input mapped read-only, output created at its final size and mapped read-write
+static int run_mapped(const Args &args, int in_fd, size_t in_size, const Process &process)
+{
+    ssize_t out_size = output_size(args, in_size);
+    if (out_size < 0)
+    {
+        fprintf(stderr, "%s: input too short\n", args.input.c_str());
+        return 2;
+    }
+    // AEAD decryption is staged in a temporary file (mode 0600) until the tag is checked
+    bool staged = (args.mode == "aead" && args.decrypt);
+    string path = staged ? args.output + ".XXXXXX" : args.output;
+    int out_fd = staged ? mkstemp(&path[0]) : open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0)
+    {
+        perror(args.output.c_str());
+        return 1;
+    }
+    if (ftruncate(out_fd, out_size) != 0)
+    {
+        perror(args.output.c_str());
+        close(out_fd);
+        if (staged)
+            unlink(path.c_str());
+        return 1;
+    }
+    // mmap() refuses empty mappings, an empty buffer stands in for them
+    uint8_t empty[1];
+    const uint8_t *in = empty;
+    uint8_t *out = empty;
+    if (in_size > 0)
+        in = static_cast<const uint8_t *>(mmap(NULL, in_size, PROT_READ, MAP_PRIVATE, in_fd, 0));
+    if (out_size > 0)
+        out = static_cast<uint8_t *>(mmap(NULL, out_size, PROT_READ | PROT_WRITE, MAP_SHARED, out_fd, 0));
+    if (in == MAP_FAILED || out == MAP_FAILED)
+    {
+        perror("mmap");
+        if (in != MAP_FAILED && in_size > 0)
+            munmap(const_cast<uint8_t *>(in), in_size);
+        if (out != MAP_FAILED && out_size > 0)
+            munmap(out, out_size);
+        close(out_fd);
+        if (staged)
+            unlink(path.c_str());
+        return 1;
+    }
+    if (in_size > 0)
+        madvise(const_cast<uint8_t *>(in), in_size, MADV_SEQUENTIAL);
+    ssize_t written = process(in, in_size, out);
+    if (in_size > 0)
+        munmap(const_cast<uint8_t *>(in), in_size);
+    if (out_size > 0)
+        munmap(out, out_size);
+    if (written < 0)
+    {
+        if (!staged && ftruncate(out_fd, 0) != 0)
+            perror(args.output.c_str());
+        close(out_fd);
+        if (staged)
+            unlink(path.c_str());
+        fprintf(stderr, "%s: authentication failed\n", args.input.c_str());
+        return 2;
+    }
+    if (staged)
+    {
+        // The permissions open() would have given, then the plaintext under its name
+        mode_t mask = umask(0);
+        umask(mask);
+        if (fchmod(out_fd, 0644 & ~mask) != 0 || rename(path.c_str(), args.output.c_str()) != 0)
+        {
+            perror(args.output.c_str());
+            close(out_fd);
+            unlink(path.c_str());
+            return 1;
+        }
+    }
+    close(out_fd);
+    return 0;
+}
+
+// CTR through two buffers: the next piece is read on another thread while this one is
+// encrypted and written
+static int run_stream_ctr(int in_fd, int out_fd, const Process &process)
+{
+    vector<uint8_t> buffer[2] = {vector<uint8_t>(STREAM_BUFFER), vector<uint8_t>(STREAM_BUFFER)};
+    int current = 0;
+    ssize_t got = read_full(in_fd, buffer[0].data(), STREAM_BUFFER);
+    while (got > 0)
+    {
+        future<ssize_t> next = async(launch::async, read_full, in_fd, buffer[1 - current].data(), STREAM_BUFFER);
+        uint8_t *piece = buffer[current].data();
+        process(piece, got, piece);
+        if (!write_full(out_fd, piece, got))
+        {
+            next.wait();
+            perror("write");
+            return 1;
+        }
+        got = next.get();
+        current = 1 - current;
+    }
+    if (got < 0)
+    {
+        perror("read");
+        return 1;
+    }
+    return 0;
+}
+
+// The whole input, then OUTPUT opened and written once the tag has been checked
+static int run_stream_aead(const Args &args, int in_fd, const Process &process)
+{
+    vector<uint8_t> in;
+    ssize_t got;
+    do
+    {
+        in.resize(in.size() + STREAM_BUFFER);
+        got = read_full(in_fd, in.data() + in.size() - STREAM_BUFFER, STREAM_BUFFER);
+        if (got < 0)
+        {
+            perror("read");
+            return 1;
+        }
+        in.resize(in.size() - STREAM_BUFFER + got);
+    } while (got > 0);
+    ssize_t out_size = output_size(args, in.size());
+    if (out_size < 0)
+    {
+        fprintf(stderr, "%s: input too short\n", args.input.c_str());
+        return 2;
+    }
+    vector<uint8_t> out(out_size + 1);
+    ssize_t written = process(in.data(), in.size(), out.data());
+    if (written < 0)
+    {
+        fprintf(stderr, "%s: authentication failed\n", args.input.c_str());
+        return 2;
+    }
+    int out_fd = (args.output == "-") ? STDOUT_FILENO : open(args.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0)
+    {
+        perror(args.output.c_str());
+        return 1;
+    }
+    bool complete = write_full(out_fd, out.data(), written);
+    if (!complete)
+        perror("write");
+    if (out_fd != STDOUT_FILENO)
+        close(out_fd);
+    return complete ? 0 : 1;
+}
+
+// false (after the usage) if the arguments cannot be used
+static bool parse_args(int argc, const char *const argv[], Args &args)
+{
+    bool direction = false;
+    for (int i = 1; i < argc; i++)
+    {
+        string opt = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (opt == "-e" || opt == "-d")
+        {
+            args.decrypt = (opt == "-d");
+            direction = true;
+        }
+        else if (opt == "--tk1")
+            args.tk1 = true;
+        else if (opt == "-k" && has_value)
+            args.key = argv[++i];
+        else if (opt == "-n" && has_value)
+            args.nonce = argv[++i];
+        else if (opt == "-m" && has_value)
+            args.mode = argv[++i];
+        else if (opt == "-c" && has_value)
+            args.cipher = argv[++i];
+        else if (opt == "-a" && has_value)
+            args.ad = argv[++i];
+        else if (opt == "-t" && has_value)
+        {
+            char *end;
+            errno = 0;
+            long threads = strtol(argv[++i], &end, 10);
+            if (*argv[i] == '\0' || *end != '\0' || errno != 0 || threads <= 0 || threads > 65536)
+            {
+                fprintf(stderr, "-t: the number of threads is between 1 and 65536\n");
+                return false;
+            }
+            args.threads = static_cast<unsigned>(threads);
+        }
+        else if (opt == "-i" && has_value)
+            args.input = argv[++i];
+        else if (opt == "-o" && has_value)
+            args.output = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return false;
+        }
+    }
+    if (!direction || (args.mode != "ctr" && args.mode != "aead"))
+    {
+        usage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+// Exit status: 0, 1 on a usage or I/O error, 2 if the input is not a valid ciphertext
+static int run(const Args &args)
+{
+    WorkStealingPool pool(args.threads);
+    Process process;
+    bool ready = false;
+    if (args.mode == "aead")
+        ready = make_aead(args, pool, process);
+    else if (args.cipher == "skinny-64-128")
+        ready = make_ctr<Skinny64_128>(args, pool, process);
+    else if (args.cipher == "skinny-64-192")
+        ready = make_ctr<Skinny64_192>(args, pool, process);
+    else if (args.cipher == "skinny-128-256")
+        ready = make_ctr<Skinny128_256>(args, pool, process);
+    else if (args.cipher == "skinny-128-384")
+        ready = make_ctr<Skinny128_384>(args, pool, process);
+    else
+        fprintf(stderr, "unknown cipher %s\n", args.cipher.c_str());
+    if (!ready)
+        return 1;
+
+    int in_fd = (args.input == "-") ? STDIN_FILENO : open(args.input.c_str(), O_RDONLY);
+    if (in_fd < 0)
+    {
+        perror(args.input.c_str());
+        return 1;
+    }
+    struct stat in_stat, out_stat;
+    bool regular = (fstat(in_fd, &in_stat) == 0 && S_ISREG(in_stat.st_mode));
+    if (args.output != "-" && stat(args.output.c_str(), &out_stat) == 0 && regular &&
+        out_stat.st_dev == in_stat.st_dev && out_stat.st_ino == in_stat.st_ino)
+    {
+        fprintf(stderr, "%s: input and output are the same file\n", args.output.c_str());
+        if (in_fd != STDIN_FILENO)
+            close(in_fd);
+        return 1;
+    }
+    int status;
+    if (regular && args.output != "-")
+        status = run_mapped(args, in_fd, static_cast<size_t>(in_stat.st_size), process);
+    else if (args.mode == "aead")
+        status = run_stream_aead(args, in_fd, process);
+    else
+    {
+        int out_fd = (args.output == "-") ? STDOUT_FILENO : open(args.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out_fd < 0)
+            perror(args.output.c_str());
+        status = (out_fd < 0) ? 1 : run_stream_ctr(in_fd, out_fd, process);
+        if (out_fd >= 0 && out_fd != STDOUT_FILENO)
+            close(out_fd);
+    }
+    if (in_fd != STDIN_FILENO)
+        close(in_fd);
+    return status;
+}
+
+static bool read_file(const string &path, vector<uint8_t> &data)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    bool read = (fstat(fd, &st) == 0);
+    if (read)
+    {
+        data.resize(st.st_size);
+        read = (read_full(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+    }
+    close(fd);
+    return read;
+}
+
+static bool write_file(const string &path, const vector<uint8_t> &data)
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0)
+        return false;
+    bool written = write_full(fd, data.data(), data.size());
+    close(fd);
+    return written;
+}
+
+// stderr sent to /dev/null while it lives (the failures the self-check provokes)
+struct QuietStderr
+{
+    int saved;
+
+    QuietStderr()
+    {
+        fflush(stderr);
+        saved = dup(STDERR_FILENO);
+        int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, STDERR_FILENO);
+        close(null_fd);
+    }
+
+    ~QuietStderr()
+    {
+        fflush(stderr);
+        dup2(saved, STDERR_FILENO);
+        close(saved);
+    }
+};
+
+static string random_hex(Xoshiro256 &rng, size_t digits)
+{
+    string hex;
+    for (size_t i = 0; i < digits; i++)
+        hex += "0123456789abcdef"[rng.next() & 0xf];
+    return hex;
+}
+
+// args run from INPUT to OUTPUT in dir, INPUT a regular file (mapped) or a FIFO fed by
+// another thread (streamed); the exit status, stderr silenced if quiet
+static int run_files(Args args, const string &dir, bool streamed, bool quiet = false)
+{
+    args.output = dir + "/out";
+    args.input = dir + "/in";
+    string fifo = dir + "/fifo";
+    vector<uint8_t> data;
+    thread feeder;
+    if (streamed)
+    {
+        if (!read_file(args.input, data) || mkfifo(fifo.c_str(), 0600) != 0)
+            return 1;
+        args.input = fifo;
+        feeder = thread([&fifo, &data]() {
+            int fd = open(fifo.c_str(), O_WRONLY);
+            if (fd >= 0)
+            {
+                write_full(fd, data.data(), data.size());
+                close(fd);
+            }
+        });
+    }
+    int status;
+    if (quiet)
+    {
+        QuietStderr silenced;
+        status = run(args);
+    }
+    else
+        status = run(args);
+    if (streamed)
+    {
+        feeder.join();
+        unlink(fifo.c_str());
+    }
+    return status;
+}
+
+// plaintext -> in, encrypted (mapped or streamed) into out, out -> in, decrypted the
+// other way; true if the result is the plaintext and the ciphertext has the expected size
+static bool round_trip(Args args, const string &dir, bool encrypt_streamed, const vector<uint8_t> &plaintext,
+                       size_t overhead, vector<uint8_t> &ciphertext)
+{
+    vector<uint8_t> decrypted;
+    args.decrypt = false;
+    if (!write_file(dir + "/in", plaintext) || run_files(args, dir, encrypt_streamed) != 0 ||
+        !read_file(dir + "/out", ciphertext) || ciphertext.size() != plaintext.size() + overhead)
+        return false;
+    args.decrypt = true;
+    if (!write_file(dir + "/in", ciphertext) || run_files(args, dir, !encrypt_streamed) != 0 ||
+        !read_file(dir + "/out", decrypted))
+        return false;
+    return decrypted == plaintext && (plaintext.size() < 16 || ciphertext != plaintext);
+}
+
+static int self_check()
+{
+    const char *tmpdir = getenv("TMPDIR");
+    string dir = string((tmpdir != NULL && *tmpdir != '\0') ? tmpdir : "/tmp") + "/skinny-file.XXXXXX";
+    if (mkdtemp(&dir[0]) == NULL)
+    {
+        perror(dir.c_str());
+        return 1;
+    }
+    // A failed run may leave the FIFO before its writer is done
+    signal(SIGPIPE, SIG_IGN);
+    Xoshiro256 rng(2026, 0);
+    // Empty, partial blocks and more than two stream buffers
+    vector<vector<uint8_t>> plaintexts;
+    for (size_t size : {size_t(0), size_t(7), size_t(1000), 2 * STREAM_BUFFER + 37})
+    {
+        vector<uint8_t> p(size);
+        for (uint8_t &byte : p)
+            byte = static_cast<uint8_t>(rng.next());
+        plaintexts.push_back(p);
+    }
+
+    // CTR: every variant, the counter in the block or in TK1, mapped then streamed and back
+    struct Variant
+    {
+        const char *name;
+        int lanes, digits;
+    };
+    const Variant variants[] = {{"skinny-64-128", 2, 1}, {"skinny-64-192", 3, 1}, {"skinny-128-256", 2, 2}, {"skinny-128-384", 3, 2}};
+    bool ctr_passed = true;
+    vector<uint8_t> ciphertext, streamed;
+    for (const Variant &v : variants)
+        for (bool tk1 : {false, true})
+        {
+            Args args;
+            args.cipher = v.name;
+            args.tk1 = tk1;
+            args.key = random_hex(rng, 16 * v.digits * (v.lanes - (tk1 ? 1 : 0)));
+            args.nonce = random_hex(rng, 16 * v.digits);
+            for (const vector<uint8_t> &p : plaintexts)
+            {
+                // Both paths give the same ciphertext
+                ctr_passed &= round_trip(args, dir, false, p, 0, ciphertext);
+                ctr_passed &= round_trip(args, dir, true, p, 0, streamed) && streamed == ciphertext;
+            }
+        }
+    printf("%-30s%s\n", "ctr round trip:", ctr_passed ? "passed" : "failed");
+
+    // AEAD: M1 (16-byte nonce) and M2 (12-byte nonce), with and without associated data
+    bool aead_passed = true, tamper_passed = true;
+    for (size_t nonce_bytes : {16, 12})
+    {
+        Args args;
+        args.mode = "aead";
+        args.key = random_hex(rng, 32);
+        args.nonce = random_hex(rng, 2 * nonce_bytes);
+        for (const char *ad : {"", "0a0b", "000102030405060708090a0b0c0d0e0f1011"})
+        {
+            args.ad = ad;
+            for (const vector<uint8_t> &p : plaintexts)
+            {
+                aead_passed &= round_trip(args, dir, false, p, SkinnyAead::TAG_BYTES, ciphertext);
+                aead_passed &= round_trip(args, dir, true, p, SkinnyAead::TAG_BYTES, streamed) && streamed == ciphertext;
+            }
+        }
+        // A flipped ciphertext or tag bit, or a truncated input: status 2, OUTPUT as it was
+        const vector<uint8_t> old_output = {'o', 'l', 'd'};
+        Args decrypt = args;
+        decrypt.decrypt = true;
+        round_trip(args, dir, false, plaintexts[2], SkinnyAead::TAG_BYTES, ciphertext);
+        for (size_t flip : {size_t(0), ciphertext.size() - 1, ciphertext.size()})
+        {
+            vector<uint8_t> tampered(ciphertext), output;
+            if (flip < tampered.size())
+                tampered[flip] ^= 0x01;
+            else
+                tampered.resize(SkinnyAead::TAG_BYTES - 1);
+            for (bool streamed_run : {false, true})
+            {
+                tamper_passed &= write_file(dir + "/in", tampered) && write_file(dir + "/out", old_output);
+                tamper_passed &= run_files(decrypt, dir, streamed_run, true) == 2;
+                tamper_passed &= read_file(dir + "/out", output) && output == old_output;
+            }
+        }
+    }
+    printf("%-30s%s\n", "aead round trip:", aead_passed ? "passed" : "failed");
+
+    // Nothing left behind but in and out: the staging files are removed on failure
+    unlink((dir + "/in").c_str());
+    unlink((dir + "/out").c_str());
+    tamper_passed &= (rmdir(dir.c_str()) == 0);
+    printf("%-30s%s\n", "tampered ciphertext:", tamper_passed ? "passed" : "failed");
+
+    // -t takes a positive number of threads
+    bool threads_passed = true;
+    for (const char *count : {"0", "-1", "-4294967295", "2x", ""})
+    {
+        const char *argv[] = {"skinny-file.o", "-e", "-t", count};
+        Args args;
+        QuietStderr silenced;
+        threads_passed &= !parse_args(4, argv, args);
+    }
+    const char *argv[] = {"skinny-file.o", "-e", "-t", "3"};
+    Args args;
+    threads_passed &= parse_args(4, argv, args) && args.threads == 3;
+    printf("%-30s%s\n", "thread count:", threads_passed ? "passed" : "failed");
+    return (ctr_passed && aead_passed && tamper_passed && threads_passed) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 1)
+        return self_check();
+    Args args;
+    if (!parse_args(argc, argv, args))
+        return 1;
+    return run(args);
+}
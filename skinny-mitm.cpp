@@ -0,0 +1,192 @@
+/*
+ * Meet-in-the-middle partial-key recovery on 3-round Skinny-64-128
+ * Date: Oct 17, 2026
+*/
+// Four known pairs of 3-round Skinny-64-128 under a random tweakey; 16 round tweakey bits
+// are guessed forward (round 0) and 16 backward (rounds 1 and 2) and matched on the cells
+// known from both sides after round 0. Checks that the true cells survive, in memory and
+// through spilled bucket files, that the matched cells do not depend on the unguessed
+// cells, that every survivor of a shorter fingerprint is a real match, that bucket files
+// that cannot be written are reported, and that setups run() cannot search are refused. Guesses of a cell
+// that reaches a matched cell linearly from both sides (here (0, 0) and (1, 0)) are only
+// determined up to their sum, which is why two pairs leave more candidates than expected.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <chrono>
+#include <vector>
+#include "skinny_mitm.h"
+#include "xoshiro256.h"
+
+using namespace std;
+using namespace skinny;
+
+typedef Skinny64_128 Cipher;
+
+uint64_t pack_guess(const vector<pair<int, int>> &cells, const uint8_t rtk[][8]);
+
+// The guess of these cells that is the actual round tweakey
+uint64_t pack_guess(const vector<pair<int, int>> &cells, const uint8_t rtk[][8])
+{
+    uint64_t guess = 0;
+    for (size_t k = 0; k < cells.size(); k++)
+        guess |= static_cast<uint64_t>(rtk[cells[k].first][cells[k].second]) << (Cipher::CELL_BITS * k);
+    return guess;
+}
+
+int main()
+{
+    const int R = Cipher::ROUNDS, PAIRS = 4;
+    MitmSetup setup;
+    setup.rounds = 3;
+    setup.middle = 1;
+    setup.forward_guess = {{0, 0}, {0, 1}, {0, 5}, {0, 6}};
+    setup.backward_guess = {{2, 4}, {2, 5}, {1, 0}, {1, 1}};
+
+    Xoshiro256 rng(2026, 0);
+    uint8_t tk[2][16], rtk[R][8];
+    for (int l = 0; l < 2; l++)
+        for (uint8_t i = 0; i < 16; i++)
+            tk[l][i] = rng.next() & Cipher::CELL_MASK;
+    Cipher::tweakey_schedule(R, tk, rtk);
+    vector<vector<uint8_t>> plaintexts(PAIRS, vector<uint8_t>(16)), ciphertexts(PAIRS, vector<uint8_t>(16));
+    for (int j = 0; j < PAIRS; j++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            plaintexts[j][i] = rng.next() & Cipher::CELL_MASK;
+        Cipher::enc(setup.rounds, plaintexts[j].data(), ciphertexts[j].data(), rtk);
+    }
+
+    Mitm<Cipher> mitm(setup, plaintexts, ciphertexts);
+    const uint64_t forward_true = pack_guess(setup.forward_guess, rtk), backward_true = pack_guess(setup.backward_guess, rtk);
+    WorkStealingPool pool;
+    typedef chrono::steady_clock clock;
+    clock::time_point start = clock::now();
+    MitmReport report = mitm.run(pool);
+    double seconds = chrono::duration<double>(clock::now() - start).count();
+    printf("%-30s%04x / %04x / %04x\n", "forward / backward / matched:", report.forward_known, report.backward_known, report.matched);
+    printf("%-30s%d bits, 2^%d x 2^%d guesses\n", "fingerprint:", report.fingerprint_bits, __builtin_ctzll(report.forward_guesses),
+           __builtin_ctzll(report.backward_guesses));
+    printf("%-30s%zu (%.3g expected false), %zu buckets, %.2f s\n", "candidates:", report.candidates.size(), report.expected_false,
+           report.buckets, seconds);
+    if (report.error != NULL)
+        printf("%-30s%s\n", "error:", report.error);
+
+    // The known cells after round 0 do not depend on the unguessed cells, and the
+    // fingerprints of the true guesses are the matched cells under the real tweakey
+    bool masks_passed = report.matched != 0;
+    for (int trial = 0; trial < 16; trial++)
+    {
+        uint8_t noisy[R][8], forward_rtk[R][8], backward_rtk[R][8];
+        for (int r = 0; r < setup.rounds; r++)
+            for (int i = 0; i < 8; i++)
+                noisy[r][i] = rng.next() & Cipher::CELL_MASK;
+        uint64_t f = rng.next() & (report.forward_guesses - 1), b = rng.next() & (report.backward_guesses - 1);
+        Mitm<Cipher>::guess_round_tweakeys(setup.forward_guess, f, forward_rtk);
+        Mitm<Cipher>::guess_round_tweakeys(setup.backward_guess, b, backward_rtk);
+        for (const pair<int, int> &c : setup.forward_guess)
+            noisy[c.first][c.second] = forward_rtk[c.first][c.second];
+        for (const pair<int, int> &c : setup.backward_guess)
+            noisy[c.first][c.second] = backward_rtk[c.first][c.second];
+        for (int j = 0; j < PAIRS; j++)
+        {
+            uint8_t state[16], state_noisy[16], back[16], back_noisy[16];
+            Cipher::enc_rounds(0, setup.middle, plaintexts[j].data(), state, forward_rtk);
+            Cipher::enc_rounds(0, setup.middle, plaintexts[j].data(), state_noisy, noisy);
+            Cipher::dec_rounds(setup.middle, setup.rounds, back, ciphertexts[j].data(), backward_rtk);
+            Cipher::dec_rounds(setup.middle, setup.rounds, back_noisy, ciphertexts[j].data(), noisy);
+            for (uint8_t i = 0; i < 16; i++)
+                if ((((report.forward_known >> i) & 0x1) && state[i] != state_noisy[i]) ||
+                    (((report.backward_known >> i) & 0x1) && back[i] != back_noisy[i]))
+                    masks_passed = false;
+        }
+    }
+    vector<uint8_t> forward_print, backward_print, expected;
+    for (int j = 0; j < PAIRS; j++)
+    {
+        uint8_t state[16];
+        Cipher::enc_rounds(0, setup.middle, plaintexts[j].data(), state, rtk);
+        for (uint8_t i = 0; i < 16; i++)
+            if ((report.matched >> i) & 0x1)
+                expected.push_back(state[i]);
+    }
+    mitm.fingerprint(true, forward_true, forward_print);
+    mitm.fingerprint(false, backward_true, backward_print);
+    if (forward_print != expected || backward_print != expected)
+        masks_passed = false;
+    printf("%-30s%s\n", "known cells:", masks_passed ? "passed" : "failed");
+
+    bool recovered = false;
+    for (const MitmCandidate &c : report.candidates)
+        recovered |= c.forward_guess == forward_true && c.backward_guess == backward_true;
+    printf("%-30s%s\n", "true tweakey cells:", recovered ? "passed" : "failed");
+
+    // Tables that do not fit: the same candidates through bucket files
+    MitmReport spilled = mitm.run(pool, 1);
+    bool spill_passed = spilled.spilled && spilled.error == NULL && spilled.buckets > report.buckets &&
+                        spilled.candidates.size() == report.candidates.size();
+    for (size_t k = 0; spill_passed && k < report.candidates.size(); k++)
+        spill_passed = spilled.candidates[k].forward_guess == report.candidates[k].forward_guess &&
+                       spilled.candidates[k].backward_guess == report.candidates[k].backward_guess;
+    printf("%-30s%s\n", "spilled buckets:", spill_passed ? "passed" : "failed");
+
+    // Bucket files cut short (a file size limit standing in for a full disk) are an error
+    struct rlimit limit, small;
+    bool full_passed = getrlimit(RLIMIT_FSIZE, &limit) == 0;
+    if (full_passed)
+    {
+        small = limit;
+        small.rlim_cur = 1024;
+        signal(SIGXFSZ, SIG_IGN);
+        setrlimit(RLIMIT_FSIZE, &small);
+        MitmReport full = mitm.run(pool, 1);
+        setrlimit(RLIMIT_FSIZE, &limit);
+        full_passed = full.spilled && full.error != NULL;
+    }
+    printf("%-30s%s\n", "full disk:", full_passed ? "passed" : "failed");
+
+    // Setups that cannot be searched
+    bool setup_passed = report.error == NULL;
+    MitmSetup bad = setup;
+    for (int r = 0; r < 2; r++)
+        for (int i = 0; i < 8; i++)
+            bad.forward_guess.push_back({r, i}); // 64 bits or more
+    setup_passed &= Mitm<Cipher>(bad, plaintexts, ciphertexts).run(pool).error != NULL;
+    bad = setup;
+    bad.backward_guess.push_back({setup.rounds, 0});
+    setup_passed &= Mitm<Cipher>(bad, plaintexts, ciphertexts).run(pool).error != NULL;
+    bad = setup;
+    bad.forward_guess.push_back({-1, 0});
+    setup_passed &= Mitm<Cipher>(bad, plaintexts, ciphertexts).run(pool).error != NULL;
+    bad = setup;
+    bad.forward_guess.clear(); // nothing known after round 0 from the plaintext side
+    setup_passed &= Mitm<Cipher>(bad, plaintexts, ciphertexts).run(pool).error != NULL;
+    setup_passed &= Mitm<Cipher>(setup, {}, {}).run(pool).error != NULL;
+    printf("%-30s%s\n", "refused setups:", setup_passed ? "passed" : "failed");
+
+    // Two pairs leave a 32-bit fingerprint: a few more candidates, every one a real match
+    vector<vector<uint8_t>> few_p(plaintexts.begin(), plaintexts.begin() + 2), few_c(ciphertexts.begin(), ciphertexts.begin() + 2);
+    MitmReport few = Mitm<Cipher>(setup, few_p, few_c).run(pool);
+    bool survivors_passed = report.candidates.size() == 1 && !few.candidates.empty();
+    for (const MitmCandidate &c : few.candidates)
+    {
+        uint8_t forward_rtk[R][8], backward_rtk[R][8];
+        Mitm<Cipher>::guess_round_tweakeys(setup.forward_guess, c.forward_guess, forward_rtk);
+        Mitm<Cipher>::guess_round_tweakeys(setup.backward_guess, c.backward_guess, backward_rtk);
+        for (int j = 0; j < 2; j++)
+        {
+            uint8_t state[16], state2[16];
+            Cipher::enc_rounds(0, setup.middle, plaintexts[j].data(), state, forward_rtk);
+            Cipher::dec_rounds(setup.middle, setup.rounds, state2, ciphertexts[j].data(), backward_rtk);
+            for (uint8_t i = 0; i < 16; i++)
+                if (((report.matched >> i) & 0x1) && state[i] != state2[i])
+                    survivors_passed = false;
+        }
+    }
+    printf("%-30s%zu of 2^32 (%.3g expected false)\n", "two pairs:", few.candidates.size(), few.expected_false);
+    printf("%-30s%s\n", "survivors:", survivors_passed ? "passed" : "failed");
+    return (masks_passed && recovered && spill_passed && full_passed && setup_passed && survivors_passed) ? 0 : 1;
+}
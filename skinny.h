@@ -0,0 +1,794 @@
+/*
+ * Header-only C++ library for the Skinny family of tweakable block ciphers
+ * Date: Oct 17, 2026
+*/
+// Skinny<BlockBits, TweakeyBits> covers Skinny-64-64/128/192 and Skinny-128-128/256/384.
+// A state is 16 cells of one byte each (row-major, one nibble per byte for Skinny-64),
+// as in the skinny-*.cpp programs, and a master tweakey is TK1 || TK2 || TK3 in the
+// same format. The round count is a template parameter (the standard count by default),
+// so encrypt() and decrypt() unroll every round at compile time.
+
+#ifndef SKINNY_H
+#define SKINNY_H
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+namespace skinny
+{
+
+// 4-bit Sbox
+inline constexpr uint8_t S4[16] = {0xc, 0x6, 0x9, 0x0, 0x1, 0xa, 0x2, 0xb, 0x3, 0x8, 0x5, 0xd, 0x4, 0xe, 0x7, 0xf};
+// 4-bit Sbox Inverse
+inline constexpr uint8_t S4inv[16] = {0x3, 0x4, 0x6, 0x8, 0xc, 0xa, 0x1, 0xe, 0x9, 0x2, 0x5, 0x7, 0x0, 0xb, 0xd, 0xf};
+// 4-bit Sbox applied to both nibbles of a byte
+inline constexpr uint8_t S2[256] = {0xcc, 0xc6, 0xc9, 0xc0, 0xc1, 0xca, 0xc2, 0xcb, 0xc3, 0xc8, 0xc5, 0xcd, 0xc4, 0xce, 0xc7, 0xcf,
+                                    0x6c, 0x66, 0x69, 0x60, 0x61, 0x6a, 0x62, 0x6b, 0x63, 0x68, 0x65, 0x6d, 0x64, 0x6e, 0x67, 0x6f,
+                                    0x9c, 0x96, 0x99, 0x90, 0x91, 0x9a, 0x92, 0x9b, 0x93, 0x98, 0x95, 0x9d, 0x94, 0x9e, 0x97, 0x9f,
+                                    0x0c, 0x06, 0x09, 0x00, 0x01, 0x0a, 0x02, 0x0b, 0x03, 0x08, 0x05, 0x0d, 0x04, 0x0e, 0x07, 0x0f,
+                                    0x1c, 0x16, 0x19, 0x10, 0x11, 0x1a, 0x12, 0x1b, 0x13, 0x18, 0x15, 0x1d, 0x14, 0x1e, 0x17, 0x1f,
+                                    0xac, 0xa6, 0xa9, 0xa0, 0xa1, 0xaa, 0xa2, 0xab, 0xa3, 0xa8, 0xa5, 0xad, 0xa4, 0xae, 0xa7, 0xaf,
+                                    0x2c, 0x26, 0x29, 0x20, 0x21, 0x2a, 0x22, 0x2b, 0x23, 0x28, 0x25, 0x2d, 0x24, 0x2e, 0x27, 0x2f,
+                                    0xbc, 0xb6, 0xb9, 0xb0, 0xb1, 0xba, 0xb2, 0xbb, 0xb3, 0xb8, 0xb5, 0xbd, 0xb4, 0xbe, 0xb7, 0xbf,
+                                    0x3c, 0x36, 0x39, 0x30, 0x31, 0x3a, 0x32, 0x3b, 0x33, 0x38, 0x35, 0x3d, 0x34, 0x3e, 0x37, 0x3f,
+                                    0x8c, 0x86, 0x89, 0x80, 0x81, 0x8a, 0x82, 0x8b, 0x83, 0x88, 0x85, 0x8d, 0x84, 0x8e, 0x87, 0x8f,
+                                    0x5c, 0x56, 0x59, 0x50, 0x51, 0x5a, 0x52, 0x5b, 0x53, 0x58, 0x55, 0x5d, 0x54, 0x5e, 0x57, 0x5f,
+                                    0xdc, 0xd6, 0xd9, 0xd0, 0xd1, 0xda, 0xd2, 0xdb, 0xd3, 0xd8, 0xd5, 0xdd, 0xd4, 0xde, 0xd7, 0xdf,
+                                    0x4c, 0x46, 0x49, 0x40, 0x41, 0x4a, 0x42, 0x4b, 0x43, 0x48, 0x45, 0x4d, 0x44, 0x4e, 0x47, 0x4f,
+                                    0xec, 0xe6, 0xe9, 0xe0, 0xe1, 0xea, 0xe2, 0xeb, 0xe3, 0xe8, 0xe5, 0xed, 0xe4, 0xee, 0xe7, 0xef,
+                                    0x7c, 0x76, 0x79, 0x70, 0x71, 0x7a, 0x72, 0x7b, 0x73, 0x78, 0x75, 0x7d, 0x74, 0x7e, 0x77, 0x7f,
+                                    0xfc, 0xf6, 0xf9, 0xf0, 0xf1, 0xfa, 0xf2, 0xfb, 0xf3, 0xf8, 0xf5, 0xfd, 0xf4, 0xfe, 0xf7, 0xff};
+// 4-bit Sbox Inverse applied to both nibbles of a byte
+inline constexpr uint8_t S2inv[256] = {0x33, 0x34, 0x36, 0x38, 0x3c, 0x3a, 0x31, 0x3e, 0x39, 0x32, 0x35, 0x37, 0x30, 0x3b, 0x3d, 0x3f,
+                                       0x43, 0x44, 0x46, 0x48, 0x4c, 0x4a, 0x41, 0x4e, 0x49, 0x42, 0x45, 0x47, 0x40, 0x4b, 0x4d, 0x4f,
+                                       0x63, 0x64, 0x66, 0x68, 0x6c, 0x6a, 0x61, 0x6e, 0x69, 0x62, 0x65, 0x67, 0x60, 0x6b, 0x6d, 0x6f,
+                                       0x83, 0x84, 0x86, 0x88, 0x8c, 0x8a, 0x81, 0x8e, 0x89, 0x82, 0x85, 0x87, 0x80, 0x8b, 0x8d, 0x8f,
+                                       0xc3, 0xc4, 0xc6, 0xc8, 0xcc, 0xca, 0xc1, 0xce, 0xc9, 0xc2, 0xc5, 0xc7, 0xc0, 0xcb, 0xcd, 0xcf,
+                                       0xa3, 0xa4, 0xa6, 0xa8, 0xac, 0xaa, 0xa1, 0xae, 0xa9, 0xa2, 0xa5, 0xa7, 0xa0, 0xab, 0xad, 0xaf,
+                                       0x13, 0x14, 0x16, 0x18, 0x1c, 0x1a, 0x11, 0x1e, 0x19, 0x12, 0x15, 0x17, 0x10, 0x1b, 0x1d, 0x1f,
+                                       0xe3, 0xe4, 0xe6, 0xe8, 0xec, 0xea, 0xe1, 0xee, 0xe9, 0xe2, 0xe5, 0xe7, 0xe0, 0xeb, 0xed, 0xef,
+                                       0x93, 0x94, 0x96, 0x98, 0x9c, 0x9a, 0x91, 0x9e, 0x99, 0x92, 0x95, 0x97, 0x90, 0x9b, 0x9d, 0x9f,
+                                       0x23, 0x24, 0x26, 0x28, 0x2c, 0x2a, 0x21, 0x2e, 0x29, 0x22, 0x25, 0x27, 0x20, 0x2b, 0x2d, 0x2f,
+                                       0x53, 0x54, 0x56, 0x58, 0x5c, 0x5a, 0x51, 0x5e, 0x59, 0x52, 0x55, 0x57, 0x50, 0x5b, 0x5d, 0x5f,
+                                       0x73, 0x74, 0x76, 0x78, 0x7c, 0x7a, 0x71, 0x7e, 0x79, 0x72, 0x75, 0x77, 0x70, 0x7b, 0x7d, 0x7f,
+                                       0x03, 0x04, 0x06, 0x08, 0x0c, 0x0a, 0x01, 0x0e, 0x09, 0x02, 0x05, 0x07, 0x00, 0x0b, 0x0d, 0x0f,
+                                       0xb3, 0xb4, 0xb6, 0xb8, 0xbc, 0xba, 0xb1, 0xbe, 0xb9, 0xb2, 0xb5, 0xb7, 0xb0, 0xbb, 0xbd, 0xbf,
+                                       0xd3, 0xd4, 0xd6, 0xd8, 0xdc, 0xda, 0xd1, 0xde, 0xd9, 0xd2, 0xd5, 0xd7, 0xd0, 0xdb, 0xdd, 0xdf,
+                                       0xf3, 0xf4, 0xf6, 0xf8, 0xfc, 0xfa, 0xf1, 0xfe, 0xf9, 0xf2, 0xf5, 0xf7, 0xf0, 0xfb, 0xfd, 0xff};
+// 8-bit Sbox
+inline constexpr uint8_t S8[256] = {0x65, 0x4c, 0x6a, 0x42, 0x4b, 0x63, 0x43, 0x6b, 0x55, 0x75, 0x5a, 0x7a, 0x53, 0x73, 0x5b, 0x7b, 0x35, 0x8c, 0x3a, 0x81, 0x89, 0x33, 0x80, 0x3b, 0x95, 0x25, 0x98, 0x2a, 0x90, 0x23, 0x99, 0x2b, 0xe5, 0xcc, 0xe8, 0xc1, 0xc9, 0xe0, 0xc0, 0xe9, 0xd5, 0xf5, 0xd8, 0xf8, 0xd0, 0xf0, 0xd9, 0xf9, 0xa5, 0x1c, 0xa8, 0x12, 0x1b, 0xa0, 0x13, 0xa9, 0x05, 0xb5, 0x0a, 0xb8, 0x03, 0xb0, 0x0b, 0xb9, 0x32, 0x88, 0x3c, 0x85, 0x8d, 0x34, 0x84, 0x3d, 0x91, 0x22, 0x9c, 0x2c, 0x94, 0x24, 0x9d, 0x2d, 0x62, 0x4a, 0x6c, 0x45, 0x4d, 0x64, 0x44, 0x6d, 0x52, 0x72, 0x5c, 0x7c, 0x54, 0x74, 0x5d, 0x7d, 0xa1, 0x1a, 0xac, 0x15, 0x1d, 0xa4, 0x14, 0xad, 0x02, 0xb1, 0x0c, 0xbc, 0x04, 0xb4, 0x0d, 0xbd, 0xe1, 0xc8, 0xec, 0xc5, 0xcd, 0xe4, 0xc4, 0xed, 0xd1, 0xf1, 0xdc, 0xfc, 0xd4, 0xf4, 0xdd, 0xfd, 0x36, 0x8e, 0x38, 0x82, 0x8b, 0x30, 0x83, 0x39, 0x96, 0x26, 0x9a, 0x28, 0x93, 0x20, 0x9b, 0x29, 0x66, 0x4e, 0x68, 0x41, 0x49, 0x60, 0x40, 0x69, 0x56, 0x76, 0x58, 0x78, 0x50, 0x70, 0x59, 0x79, 0xa6, 0x1e, 0xaa, 0x11, 0x19, 0xa3, 0x10, 0xab, 0x06, 0xb6, 0x08, 0xba, 0x00, 0xb3, 0x09, 0xbb, 0xe6, 0xce, 0xea, 0xc2, 0xcb, 0xe3, 0xc3, 0xeb, 0xd6, 0xf6, 0xda, 0xfa, 0xd3, 0xf3, 0xdb, 0xfb, 0x31, 0x8a, 0x3e, 0x86, 0x8f, 0x37, 0x87, 0x3f, 0x92, 0x21, 0x9e, 0x2e, 0x97, 0x27, 0x9f, 0x2f, 0x61, 0x48, 0x6e, 0x46, 0x4f, 0x67, 0x47, 0x6f, 0x51, 0x71, 0x5e, 0x7e, 0x57, 0x77, 0x5f, 0x7f, 0xa2, 0x18, 0xae, 0x16, 0x1f, 0xa7, 0x17, 0xaf, 0x01, 0xb2, 0x0e, 0xbe, 0x07, 0xb7, 0x0f, 0xbf, 0xe2, 0xca, 0xee, 0xc6, 0xcf, 0xe7, 0xc7, 0xef, 0xd2, 0xf2, 0xde, 0xfe, 0xd7, 0xf7, 0xdf, 0xff};
+// 8-bit Sbox Inverse
+inline constexpr uint8_t S8inv[256] = {0xac, 0xe8, 0x68, 0x3c, 0x6c, 0x38, 0xa8, 0xec, 0xaa, 0xae, 0x3a, 0x3e, 0x6a, 0x6e, 0xea, 0xee, 0xa6, 0xa3, 0x33, 0x36, 0x66, 0x63, 0xe3, 0xe6, 0xe1, 0xa4, 0x61, 0x34, 0x31, 0x64, 0xa1, 0xe4, 0x8d, 0xc9, 0x49, 0x1d, 0x4d, 0x19, 0x89, 0xcd, 0x8b, 0x8f, 0x1b, 0x1f, 0x4b, 0x4f, 0xcb, 0xcf, 0x85, 0xc0, 0x40, 0x15, 0x45, 0x10, 0x80, 0xc5, 0x82, 0x87, 0x12, 0x17, 0x42, 0x47, 0xc2, 0xc7, 0x96, 0x93, 0x03, 0x06, 0x56, 0x53, 0xd3, 0xd6, 0xd1, 0x94, 0x51, 0x04, 0x01, 0x54, 0x91, 0xd4, 0x9c, 0xd8, 0x58, 0x0c, 0x5c, 0x08, 0x98, 0xdc, 0x9a, 0x9e, 0x0a, 0x0e, 0x5a, 0x5e, 0xda, 0xde, 0x95, 0xd0, 0x50, 0x05, 0x55, 0x00, 0x90, 0xd5, 0x92, 0x97, 0x02, 0x07, 0x52, 0x57, 0xd2, 0xd7, 0x9d, 0xd9, 0x59, 0x0d, 0x5d, 0x09, 0x99, 0xdd, 0x9b, 0x9f, 0x0b, 0x0f, 0x5b, 0x5f, 0xdb, 0xdf, 0x16, 0x13, 0x83, 0x86, 0x46, 0x43, 0xc3, 0xc6, 0x41, 0x14, 0xc1, 0x84, 0x11, 0x44, 0x81, 0xc4, 0x1c, 0x48, 0xc8, 0x8c, 0x4c, 0x18, 0x88, 0xcc, 0x1a, 0x1e, 0x8a, 0x8e, 0x4a, 0x4e, 0xca, 0xce, 0x35, 0x60, 0xe0, 0xa5, 0x65, 0x30, 0xa0, 0xe5, 0x32, 0x37, 0xa2, 0xa7, 0x62, 0x67, 0xe2, 0xe7, 0x3d, 0x69, 0xe9, 0xad, 0x6d, 0x39, 0xa9, 0xed, 0x3b, 0x3f, 0xab, 0xaf, 0x6b, 0x6f, 0xeb, 0xef, 0x26, 0x23, 0xb3, 0xb6, 0x76, 0x73, 0xf3, 0xf6, 0x71, 0x24, 0xf1, 0xb4, 0x21, 0x74, 0xb1, 0xf4, 0x2c, 0x78, 0xf8, 0xbc, 0x7c, 0x28, 0xb8, 0xfc, 0x2a, 0x2e, 0xba, 0xbe, 0x7a, 0x7e, 0xfa, 0xfe, 0x25, 0x70, 0xf0, 0xb5, 0x75, 0x20, 0xb0, 0xf5, 0x22, 0x27, 0xb2, 0xb7, 0x72, 0x77, 0xf2, 0xf7, 0x2d, 0x79, 0xf9, 0xbd, 0x7d, 0x29, 0xb9, 0xfd, 0x2b, 0x2f, 0xbb, 0xbf, 0x7b, 0x7f, 0xfb, 0xff};
+// Permutation
+inline constexpr uint8_t P[16] = {0x0, 0x1, 0x2, 0x3, 0x7, 0x4, 0x5, 0x6, 0xa, 0xb, 0x8, 0x9, 0xd, 0xe, 0xf, 0xc};
+inline constexpr uint8_t Pinv[16] = {0x0, 0x1, 0x2, 0x3, 0x5, 0x6, 0x7, 0x4, 0xa, 0xb, 0x8, 0x9, 0xf, 0xc, 0xd, 0xe};
+// Tweakey Permutation
+inline constexpr uint8_t Q[16] = {0x9, 0xf, 0x8, 0xd, 0xa, 0xe, 0xc, 0xb, 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7};
+inline constexpr uint8_t Qinv[16] = {0x8, 0x9, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf, 0x2, 0x0, 0x4, 0x7, 0x6, 0x3, 0x5, 0x1};
+// Round Constants (enough for every variant, the first R are used)
+inline constexpr uint8_t RC[62] = {0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3E, 0x3D, 0x3B, 0x37, 0x2F,
+                                   0x1E, 0x3C, 0x39, 0x33, 0x27, 0x0E, 0x1D, 0x3A, 0x35, 0x2B,
+                                   0x16, 0x2C, 0x18, 0x30, 0x21, 0x02, 0x05, 0x0B, 0x17, 0x2E,
+                                   0x1C, 0x38, 0x31, 0x23, 0x06, 0x0D, 0x1B, 0x36, 0x2D, 0x1A,
+                                   0x34, 0x29, 0x12, 0x24, 0x08, 0x11, 0x22, 0x04, 0x09, 0x13,
+                                   0x26, 0x0c, 0x19, 0x32, 0x25, 0x0a, 0x15, 0x2a, 0x14, 0x28,
+                                   0x10, 0x20};
+
+inline void mix_columns(uint8_t state[16])
+{
+    uint8_t tmp;
+    for (uint8_t j = 0; j < 4; j++)
+    {
+        state[j + 4 * 1] ^= state[j + 4 * 2];
+        state[j + 4 * 2] ^= state[j + 4 * 0];
+        state[j + 4 * 3] ^= state[j + 4 * 2];
+        tmp = state[j + 4 * 3];
+        state[j + 4 * 3] = state[j + 4 * 2];
+        state[j + 4 * 2] = state[j + 4 * 1];
+        state[j + 4 * 1] = state[j + 4 * 0];
+        state[j + 4 * 0] = tmp;
+    }
+}
+
+inline void inv_mix_columns(uint8_t state[16])
+{
+    uint8_t tmp;
+    for (uint8_t j = 0; j < 4; j++)
+    {
+        tmp = state[j + 4 * 3];
+        state[j + 4 * 3] = state[j + 4 * 0];
+        state[j + 4 * 0] = state[j + 4 * 1];
+        state[j + 4 * 1] = state[j + 4 * 2];
+        state[j + 4 * 2] = tmp;
+        state[j + 4 * 3] ^= state[j + 4 * 2];
+        state[j + 4 * 2] ^= state[j + 4 * 0];
+        state[j + 4 * 1] ^= state[j + 4 * 2];
+    }
+}
+
+// Calls f(std::integral_constant<int, i>()) for i = 0, ..., N - 1, so that the index
+// is a constant expression inside f and every call is emitted separately
+template <typename F, int... I>
+inline void unroll_impl(F &f, std::integer_sequence<int, I...>)
+{
+    (f(std::integral_constant<int, I>()), ...);
+}
+
+template <int N, typename F>
+inline void unroll(F &&f)
+{
+    unroll_impl(f, std::make_integer_sequence<int, N>());
+}
+
+// Steps of a round, in encryption order
+enum TraceStep
+{
+    TRACE_SUB_CELLS,
+    TRACE_ADD_CONSTANTS,
+    TRACE_ADD_ROUND_TWEAKEY,
+    TRACE_SHIFT_ROWS,
+    TRACE_MIX_COLUMNS,
+    TRACE_STEPS
+};
+
+// Trace policies of enc_rounds()/dec_rounds(), encrypt()/decrypt() and the bitsliced batch
+// kernels. A policy is called after every step of round `round` with the cells of blocks
+// first, ..., first + count - 1 of the batch; decryption calls it after undoing the step, so
+// e.g. TRACE_MIX_COLUMNS then sees the state encryption has after TRACE_SHIFT_ROWS. The
+// calls sit behind `if constexpr (Trace::ENABLED)`, so NoTrace (the default everywhere)
+// compiles to the untraced code.
+struct NoTrace
+{
+    static constexpr bool ENABLED = false;
+    void operator()(int, TraceStep, size_t, size_t, const uint8_t[][16]) const {}
+};
+
+// Copies every traced state into states[(TRACE_STEPS * round + step) * blocks + block], a
+// caller-provided buffer of TRACE_STEPS * rounds * blocks states (blocks = 1 for one block)
+struct StateTrace
+{
+    static constexpr bool ENABLED = true;
+    uint8_t (*states)[16];
+    size_t blocks;
+
+    void operator()(int round, TraceStep step, size_t first, size_t count, const uint8_t state[][16]) const
+    {
+        memcpy(states[(TRACE_STEPS * static_cast<size_t>(round) + step) * blocks + first], state, 16 * count);
+    }
+};
+
+// Round constants of round r on a state in cells: the traced AddConstants state of kernels
+// that add constants and round tweakey in one go
+inline void add_constants_cells(int r, uint8_t state[16])
+{
+    state[0] ^= (RC[r] & 0xf);
+    state[4] ^= ((RC[r] >> 4) & 0x3);
+    state[8] ^= 0x2;
+}
+
+constexpr int default_rounds(int block_bits, int tweakey_bits)
+{
+    // 32/36/40 rounds for Skinny-64, 40/48/56 for Skinny-128 (one, two or three TK lanes)
+    return (block_bits == 64) ? 28 + 4 * (tweakey_bits / 64) : 32 + 8 * (tweakey_bits / 128);
+}
+
+template <int BlockBits, int TweakeyBits, int Rounds = default_rounds(BlockBits, TweakeyBits)>
+class Skinny
+{
+    static_assert(BlockBits == 64 || BlockBits == 128, "Skinny has 64-bit and 128-bit blocks");
+    static_assert(TweakeyBits == BlockBits || TweakeyBits == 2 * BlockBits || TweakeyBits == 3 * BlockBits,
+                  "the tweakey has one, two or three lanes of the block size");
+    static_assert(Rounds > 0 && Rounds <= (int)sizeof(RC), "no round constants for this many rounds");
+
+public:
+    static constexpr int BLOCK_BITS = BlockBits;
+    static constexpr int TWEAKEY_BITS = TweakeyBits;
+    static constexpr int ROUNDS = Rounds;
+    static constexpr int CELL_BITS = BlockBits / 16;
+    static constexpr int LANES = TweakeyBits / BlockBits;
+    static constexpr uint8_t CELL_MASK = (1 << CELL_BITS) - 1;
+
+    // Row i of the state as one word, cell (i, c) in bits CELL_BITS * c and up
+    typedef typename std::conditional<BlockBits == 64, uint16_t, uint32_t>::type row_t;
+
+    // Expanded tweakey used by encrypt() and decrypt(): the two upper rows of every
+    // round tweakey. The round constants are not included, they are folded in per round.
+    struct Key
+    {
+        row_t rtk[Rounds][2];
+    };
+
+    // Tweak context: TK2 (and TK3) are fixed as the key while TK1 changes per block as the
+    // tweak. The tweakey schedule is linear, so the key part of every round tweakey is
+    // computed once and a new TK1 only adds its own (LFSR-free) contribution.
+    struct TweakContext
+    {
+        // Key part of every round tweakey, in both formats
+        uint8_t key_rtk[Rounds][8];
+        row_t key_rows[Rounds][2];
+        // TK1 cell that lands on round-tweakey cell i in round r (TK1 only goes through Q)
+        uint8_t tk1_index[Rounds][8];
+    };
+
+    // Tweakey state of one round, all lanes as rows: the round tweakey is the XOR of the two
+    // upper rows of the lanes. 16 to 48 bytes, advanced round by round (next_tweakey()) or
+    // stepped back (prev_tweakey()) instead of storing every round tweakey.
+    struct TweakeyState
+    {
+        row_t t[LANES][4];
+    };
+
+    // LFSR on one cell of the two upper rows of TK2
+    static constexpr uint8_t tk2_lfsr(uint8_t x)
+    {
+        if constexpr (CELL_BITS == 4)
+            return static_cast<uint8_t>(((x << 1) ^ ((x >> 3) & 0x1) ^ ((x >> 2) & 0x1)) & 0xf);
+        else
+            return static_cast<uint8_t>(((x << 1) & 0xFE) ^ (((x >> 7) ^ (x >> 5)) & 0x01));
+    }
+
+    // LFSR on one cell of the two upper rows of TK3
+    static constexpr uint8_t tk3_lfsr(uint8_t x)
+    {
+        if constexpr (CELL_BITS == 4)
+            return static_cast<uint8_t>(((x >> 1) ^ (((x & 0x1) ^ ((x >> 3) & 0x1)) << 3)) & 0xf);
+        else
+            return static_cast<uint8_t>(((x >> 1) & 0x7F) ^ (((x << 7) ^ (x << 1)) & 0x80));
+    }
+
+    // The same LFSRs on every cell of a row word
+    static constexpr row_t tk2_lfsr_row(row_t x)
+    {
+        if constexpr (CELL_BITS == 4)
+            return static_cast<row_t>(((x << 1) & 0xEEEE) ^ (((x >> 3) ^ (x >> 2)) & 0x1111));
+        else
+            return ((x << 1) & 0xFEFEFEFE) ^ (((x >> 7) ^ (x >> 5)) & 0x01010101);
+    }
+
+    static constexpr row_t tk3_lfsr_row(row_t x)
+    {
+        if constexpr (CELL_BITS == 4)
+            return static_cast<row_t>(((x >> 1) & 0x7777) ^ (((x << 3) ^ x) & 0x8888));
+        else
+            return ((x >> 1) & 0x7F7F7F7F) ^ (((x << 7) ^ (x << 1)) & 0x80808080);
+    }
+
+    // Cell-wise reference implementation with a run-time round count (R <= sizeof(RC)).
+    // tk holds the LANES master lanes TK1, TK2, TK3; round_tweakey gets the two upper rows.
+    static void tweakey_schedule(int rounds, const uint8_t tk[][16], uint8_t round_tweakey[][8])
+    {
+        uint8_t t[LANES][16];
+        uint8_t temp[16];
+        for (int l = 0; l < LANES; l++)
+            for (uint8_t i = 0; i < 16; i++)
+                t[l][i] = tk[l][i] & CELL_MASK;
+        for (int r = 0; r < rounds; r++)
+        {
+            if (r > 0)
+            {
+                // Apply tweakey permutation on every lane, then LFSRs on the two upper rows
+                // of TK2 and TK3 (LFSRs are not performed on TK1 at all)
+                for (int l = 0; l < LANES; l++)
+                {
+                    for (uint8_t i = 0; i < 16; i++)
+                        temp[i] = t[l][i];
+                    for (uint8_t i = 0; i < 16; i++)
+                        t[l][i] = temp[Q[i]];
+                }
+                for (uint8_t i = 0; i < 8; i++)
+                {
+                    if constexpr (LANES > 1)
+                        t[1][i] = tk2_lfsr(t[1][i]);
+                    if constexpr (LANES > 2)
+                        t[LANES - 1][i] = tk3_lfsr(t[LANES - 1][i]);
+                }
+            }
+            // Update round tweakey
+            for (uint8_t i = 0; i < 8; i++)
+            {
+                round_tweakey[r][i] = 0;
+                for (int l = 0; l < LANES; l++)
+                    round_tweakey[r][i] ^= t[l][i];
+            }
+        }
+    }
+
+    template <class Trace = NoTrace>
+    static void enc(int R, const uint8_t plaintext[16], uint8_t ciphertext[16], const uint8_t tk[][8], const Trace &trace = Trace())
+    {
+        enc_rounds(0, R, plaintext, ciphertext, tk, trace);
+    }
+
+    template <class Trace = NoTrace>
+    static void dec(int R, uint8_t plaintext[16], const uint8_t ciphertext[16], const uint8_t tk[][8], const Trace &trace = Trace())
+    {
+        dec_rounds(0, R, plaintext, ciphertext, tk, trace);
+    }
+
+    // Rounds first, ..., last - 1 only, e.g. from an intermediate state (tk[r] is still the
+    // round tweakey of round r)
+    template <class Trace = NoTrace>
+    static void enc_rounds(int first, int last, const uint8_t plaintext[16], uint8_t ciphertext[16], const uint8_t tk[][8],
+                           const Trace &trace = Trace())
+    {
+        uint8_t temp[16];
+        for (uint8_t i = 0; i < 16; i++)
+            ciphertext[i] = plaintext[i] & CELL_MASK;
+        for (int r = first; r < last; r++)
+        {
+            // SBox
+            for (uint8_t i = 0; i < 16; i++)
+                ciphertext[i] = sbox_cell(ciphertext[i]);
+            trace_cells(trace, r, TRACE_SUB_CELLS, ciphertext);
+            // Add constants (constants only affects on three upper cells of the first column)
+            ciphertext[0] ^= (RC[r] & 0xf);
+            ciphertext[4] ^= ((RC[r] >> 4) & 0x3);
+            ciphertext[8] ^= 0x2;
+            trace_cells(trace, r, TRACE_ADD_CONSTANTS, ciphertext);
+            // Add round tweakey (tweakey only exclusive-ored with two upper rows of the state)
+            for (uint8_t i = 0; i < 8; i++)
+                ciphertext[i] ^= tk[r][i];
+            trace_cells(trace, r, TRACE_ADD_ROUND_TWEAKEY, ciphertext);
+            // Permute cells
+            for (uint8_t i = 0; i < 16; i++)
+                temp[i] = ciphertext[i];
+            for (uint8_t i = 0; i < 16; i++)
+                ciphertext[i] = temp[P[i]];
+            trace_cells(trace, r, TRACE_SHIFT_ROWS, ciphertext);
+            // MixColumn
+            mix_columns(ciphertext);
+            trace_cells(trace, r, TRACE_MIX_COLUMNS, ciphertext);
+        }
+    }
+
+    // Inverse of rounds last - 1, ..., first: the state before round first
+    template <class Trace = NoTrace>
+    static void dec_rounds(int first, int last, uint8_t plaintext[16], const uint8_t ciphertext[16], const uint8_t tk[][8],
+                           const Trace &trace = Trace())
+    {
+        uint8_t temp[16];
+        for (uint8_t i = 0; i < 16; i++)
+            plaintext[i] = ciphertext[i] & CELL_MASK;
+        for (int r = last - 1; r >= first; r--)
+        {
+            // MixColumn inverse
+            inv_mix_columns(plaintext);
+            trace_cells(trace, r, TRACE_MIX_COLUMNS, plaintext);
+            // Permute cells inverse
+            for (uint8_t i = 0; i < 16; i++)
+                temp[i] = plaintext[i];
+            for (uint8_t i = 0; i < 16; i++)
+                plaintext[i] = temp[Pinv[i]];
+            trace_cells(trace, r, TRACE_SHIFT_ROWS, plaintext);
+            // Add tweakey
+            for (uint8_t i = 0; i < 8; i++)
+                plaintext[i] ^= tk[r][i];
+            trace_cells(trace, r, TRACE_ADD_ROUND_TWEAKEY, plaintext);
+            // Add constants
+            plaintext[0] ^= (RC[r] & 0xf);
+            plaintext[4] ^= ((RC[r] >> 4) & 0x3);
+            plaintext[8] ^= 0x2;
+            trace_cells(trace, r, TRACE_ADD_CONSTANTS, plaintext);
+            // SBox inverse
+            for (uint8_t i = 0; i < 16; i++)
+                plaintext[i] = inv_sbox_cell(plaintext[i]);
+            trace_cells(trace, r, TRACE_SUB_CELLS, plaintext);
+        }
+    }
+
+    // Matches TweakeyCache::expand_fn: master is TK1 || TK2 || TK3, 16 cells per lane
+    static void expand_master_tweakey(const uint8_t *master, uint8_t round_tweakey[][8], int rounds)
+    {
+        uint8_t tk[LANES][16];
+        memcpy(tk, master, sizeof(tk));
+        tweakey_schedule(rounds, tk, round_tweakey);
+    }
+
+    // Row-as-word implementation with the round loop unrolled at compile time
+    static void load_rows(const uint8_t state[16], row_t rows[4])
+    {
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            rows[i] = 0;
+            for (uint8_t c = 0; c < 4; c++)
+                rows[i] |= static_cast<row_t>((state[4 * i + c] & CELL_MASK) << (CELL_BITS * c));
+        }
+    }
+
+    static void store_rows(const row_t rows[4], uint8_t state[16])
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            state[i] = static_cast<uint8_t>((rows[i >> 2] >> (CELL_BITS * (i & 0x3))) & CELL_MASK);
+    }
+
+    static void expand_key(const uint8_t tk[][16], Key &key)
+    {
+        TweakeyState state;
+        load_tweakey(tk, state);
+        for (int r = 0; r < Rounds; r++)
+        {
+            if (r > 0)
+                next_tweakey(state);
+            round_tweakey_rows(state, key.rtk[r]);
+        }
+    }
+
+    // On-the-fly tweakey schedule: state becomes the tweakey state of round round (0 is the
+    // master tweakey tk, ROUNDS - 1 is where decryption starts)
+    static void load_tweakey(const uint8_t tk[][16], TweakeyState &state, int round = 0)
+    {
+        for (int l = 0; l < LANES; l++)
+            load_rows(tk[l], state.t[l]);
+        for (int r = 0; r < round; r++)
+            next_tweakey(state);
+    }
+
+    // Tweakey permutation on every lane, then the LFSRs on the two upper rows of TK2 and TK3
+    static inline void next_tweakey(TweakeyState &state)
+    {
+        for (int l = 0; l < LANES; l++)
+            permute_tweakey_rows(state.t[l]);
+        if constexpr (LANES > 1)
+        {
+            state.t[1][0] = tk2_lfsr_row(state.t[1][0]);
+            state.t[1][1] = tk2_lfsr_row(state.t[1][1]);
+        }
+        if constexpr (LANES > 2)
+        {
+            state.t[LANES - 1][0] = tk3_lfsr_row(state.t[LANES - 1][0]);
+            state.t[LANES - 1][1] = tk3_lfsr_row(state.t[LANES - 1][1]);
+        }
+    }
+
+    // Inverse of next_tweakey(): the TK2 and TK3 LFSRs are each other's inverse, then Q inverse
+    static inline void prev_tweakey(TweakeyState &state)
+    {
+        if constexpr (LANES > 1)
+        {
+            state.t[1][0] = tk3_lfsr_row(state.t[1][0]);
+            state.t[1][1] = tk3_lfsr_row(state.t[1][1]);
+        }
+        if constexpr (LANES > 2)
+        {
+            state.t[LANES - 1][0] = tk2_lfsr_row(state.t[LANES - 1][0]);
+            state.t[LANES - 1][1] = tk2_lfsr_row(state.t[LANES - 1][1]);
+        }
+        for (int l = 0; l < LANES; l++)
+            inv_permute_tweakey_rows(state.t[l]);
+    }
+
+    static inline void round_tweakey_rows(const TweakeyState &state, row_t rtk[2])
+    {
+        rtk[0] = rtk[1] = 0;
+        for (int l = 0; l < LANES; l++)
+        {
+            rtk[0] ^= state.t[l][0];
+            rtk[1] ^= state.t[l][1];
+        }
+    }
+
+    // Encrypts with the first R round tweakeys of key (R = Rounds by default)
+    template <int R = Rounds>
+    static void encrypt(const Key &key, const uint8_t plaintext[16], uint8_t ciphertext[16])
+    {
+        static_assert(R > 0 && R <= Rounds, "the key holds Rounds round tweakeys");
+        row_t s[4];
+        load_rows(plaintext, s);
+        unroll<R>([&](auto r) {
+            constexpr int i = decltype(r)::value;
+            enc_round(s, key.rtk[i], RC[i] & 0xf, (RC[i] >> 4) & 0x3);
+        });
+        store_rows(s, ciphertext);
+    }
+
+    template <int R = Rounds>
+    static void decrypt(const Key &key, uint8_t plaintext[16], const uint8_t ciphertext[16])
+    {
+        static_assert(R > 0 && R <= Rounds, "the key holds Rounds round tweakeys");
+        row_t s[4];
+        load_rows(ciphertext, s);
+        unroll<R>([&](auto r) {
+            constexpr int i = R - 1 - decltype(r)::value;
+            dec_round(s, key.rtk[i], RC[i] & 0xf, (RC[i] >> 4) & 0x3);
+        });
+        store_rows(s, plaintext);
+    }
+
+    // Traced encrypt() and decrypt(): the rows add constants and round tweakey in one go, so
+    // these run the same rounds through enc_rounds()/dec_rounds(), which trace every step.
+    // They are separate overloads, so the untraced ones stay exactly as they are.
+    template <int R = Rounds, class Trace>
+    static void encrypt(const Key &key, const uint8_t plaintext[16], uint8_t ciphertext[16], const Trace &trace)
+    {
+        static_assert(R > 0 && R <= Rounds, "the key holds Rounds round tweakeys");
+        uint8_t rtk[R][8];
+        round_tweakey_cells(key, R, rtk);
+        enc_rounds(0, R, plaintext, ciphertext, rtk, trace);
+    }
+
+    template <int R = Rounds, class Trace>
+    static void decrypt(const Key &key, uint8_t plaintext[16], const uint8_t ciphertext[16], const Trace &trace)
+    {
+        static_assert(R > 0 && R <= Rounds, "the key holds Rounds round tweakeys");
+        uint8_t rtk[R][8];
+        round_tweakey_cells(key, R, rtk);
+        dec_rounds(0, R, plaintext, ciphertext, rtk, trace);
+    }
+
+    // Encryption with the round tweakeys generated round by round from the state of round 0
+    // (load_tweakey()), and decryption stepping back from the state of round R - 1; no
+    // round tweakey array is kept. Same results as enc() and dec() with tweakey_schedule().
+    static void enc_otf(int R, const uint8_t plaintext[16], uint8_t ciphertext[16], const TweakeyState &first)
+    {
+        TweakeyState state = first;
+        row_t s[4], rtk[2];
+        load_rows(plaintext, s);
+        for (int r = 0; r < R; r++)
+        {
+            if (r > 0)
+                next_tweakey(state);
+            round_tweakey_rows(state, rtk);
+            enc_round(s, rtk, RC[r] & 0xf, (RC[r] >> 4) & 0x3);
+        }
+        store_rows(s, ciphertext);
+    }
+
+    static void dec_otf(int R, uint8_t plaintext[16], const uint8_t ciphertext[16], const TweakeyState &last)
+    {
+        TweakeyState state = last;
+        row_t s[4], rtk[2];
+        load_rows(ciphertext, s);
+        for (int r = R - 1; r >= 0; r--)
+        {
+            if (r < R - 1)
+                prev_tweakey(state);
+            round_tweakey_rows(state, rtk);
+            dec_round(s, rtk, RC[r] & 0xf, (RC[r] >> 4) & 0x3);
+        }
+        store_rows(s, plaintext);
+    }
+
+    // The same with the rounds unrolled at compile time
+    template <int R = Rounds>
+    static void encrypt_otf(const TweakeyState &first, const uint8_t plaintext[16], uint8_t ciphertext[16])
+    {
+        static_assert(R > 0 && R <= Rounds, "no round constants for this many rounds");
+        TweakeyState state = first;
+        row_t s[4], rtk[2];
+        load_rows(plaintext, s);
+        unroll<R>([&](auto r) {
+            constexpr int i = decltype(r)::value;
+            if constexpr (i > 0)
+                next_tweakey(state);
+            round_tweakey_rows(state, rtk);
+            enc_round(s, rtk, RC[i] & 0xf, (RC[i] >> 4) & 0x3);
+        });
+        store_rows(s, ciphertext);
+    }
+
+    template <int R = Rounds>
+    static void decrypt_otf(const TweakeyState &last, uint8_t plaintext[16], const uint8_t ciphertext[16])
+    {
+        static_assert(R > 0 && R <= Rounds, "no round constants for this many rounds");
+        TweakeyState state = last;
+        row_t s[4], rtk[2];
+        load_rows(ciphertext, s);
+        unroll<R>([&](auto r) {
+            constexpr int i = R - 1 - decltype(r)::value;
+            if constexpr (i < R - 1)
+                prev_tweakey(state);
+            round_tweakey_rows(state, rtk);
+            dec_round(s, rtk, RC[i] & 0xf, (RC[i] >> 4) & 0x3);
+        });
+        store_rows(s, plaintext);
+    }
+
+    // The first rounds round tweakeys of key back in cells, as tweakey_schedule() has them
+    static void round_tweakey_cells(const Key &key, int rounds, uint8_t round_tweakey[][8])
+    {
+        for (int r = 0; r < rounds; r++)
+            for (uint8_t i = 0; i < 8; i++)
+                round_tweakey[r][i] = static_cast<uint8_t>((key.rtk[r][i >> 2] >> (CELL_BITS * (i & 0x3))) & CELL_MASK);
+    }
+
+    // key holds the LANES - 1 key lanes (TK2, TK3)
+    static void init_tweak_context(TweakContext *ctx, const uint8_t key[][16])
+    {
+        uint8_t tk[LANES][16];
+        uint8_t pos[16], temp[16];
+        Key rows;
+        // Key part: the ordinary schedule with TK1 = 0
+        memset(tk[0], 0, 16);
+        for (int l = 1; l < LANES; l++)
+            memcpy(tk[l], key[l - 1], 16);
+        tweakey_schedule(Rounds, tk, ctx->key_rtk);
+        expand_key(tk, rows);
+        memcpy(ctx->key_rows, rows.rtk, sizeof(rows.rtk));
+        // Follow every TK1 cell through the tweakey permutation
+        for (uint8_t i = 0; i < 16; i++)
+            pos[i] = i;
+        for (int r = 0; r < Rounds; r++)
+        {
+            for (uint8_t i = 0; i < 8; i++)
+                ctx->tk1_index[r][i] = pos[i];
+            for (uint8_t i = 0; i < 16; i++)
+                temp[i] = pos[i];
+            for (uint8_t i = 0; i < 16; i++)
+                pos[i] = temp[Q[i]];
+        }
+    }
+
+    static void tweak_round_tweakeys(const TweakContext *ctx, const uint8_t tk1[16], uint8_t round_tweakey[][8])
+    {
+        // Same output as tweakey_schedule() for this TK1, at one gather and XOR per cell
+        for (int r = 0; r < Rounds; r++)
+            for (uint8_t i = 0; i < 8; i++)
+                round_tweakey[r][i] = ctx->key_rtk[r][i] ^ (tk1[ctx->tk1_index[r][i]] & CELL_MASK);
+    }
+
+    static void tweak_key(const TweakContext *ctx, const uint8_t tk1[16], Key &key)
+    {
+        // Same output as expand_key() for this TK1
+        add_tk1(ctx->key_rows, tk1, key);
+    }
+
+    // key = base plus the contribution of tk1, base being expanded with TK1 = 0. Only the
+    // Q chain of TK1 is run.
+    static void add_tk1(const row_t base[][2], const uint8_t tk1[16], Key &key)
+    {
+        row_t t1[4];
+        load_rows(tk1, t1);
+        for (int r = 0; r < Rounds; r++)
+        {
+            if (r > 0)
+                permute_tweakey_rows(t1);
+            key.rtk[r][0] = base[r][0] ^ t1[0];
+            key.rtk[r][1] = base[r][1] ^ t1[1];
+        }
+    }
+
+private:
+    static constexpr uint8_t sbox_cell(uint8_t x)
+    {
+        if constexpr (CELL_BITS == 4)
+            return S4[x];
+        else
+            return S8[x];
+    }
+
+    static constexpr uint8_t inv_sbox_cell(uint8_t x)
+    {
+        if constexpr (CELL_BITS == 4)
+            return S4inv[x];
+        else
+            return S8inv[x];
+    }
+
+    static inline row_t sub_cells_row(row_t x)
+    {
+        // Two nibbles per lookup for Skinny-64, one byte per lookup for Skinny-128
+        if constexpr (CELL_BITS == 4)
+            return static_cast<row_t>(S2[x & 0xff] | (S2[x >> 8] << 8));
+        else
+            return S8[x & 0xff] | (S8[(x >> 8) & 0xff] << 8) | (S8[(x >> 16) & 0xff] << 16) | ((uint32_t)S8[x >> 24] << 24);
+    }
+
+    static inline row_t inv_sub_cells_row(row_t x)
+    {
+        if constexpr (CELL_BITS == 4)
+            return static_cast<row_t>(S2inv[x & 0xff] | (S2inv[x >> 8] << 8));
+        else
+            return S8inv[x & 0xff] | (S8inv[(x >> 8) & 0xff] << 8) | (S8inv[(x >> 16) & 0xff] << 16) | ((uint32_t)S8inv[x >> 24] << 24);
+    }
+
+    static constexpr row_t rotl_row(row_t x, int cells)
+    {
+        return static_cast<row_t>((x << (CELL_BITS * cells)) | (x >> (4 * CELL_BITS - CELL_BITS * cells)));
+    }
+
+    static inline void permute_tweakey_rows(row_t tk[4])
+    {
+        // Tweakey permutation Q: the two upper rows move down, the two lower rows are shuffled up
+        const int c = CELL_BITS;
+        const row_t m = CELL_MASK;
+        row_t r0 = static_cast<row_t>(((tk[2] >> c) & m) | ((tk[3] >> (2 * c)) & (m << c)) |
+                                      ((tk[2] << (2 * c)) & (m << (2 * c))) | ((tk[3] << (2 * c)) & (m << (3 * c))));
+        row_t r1 = static_cast<row_t>(((tk[2] >> (2 * c)) & m) | ((tk[3] >> c) & (m << c)) |
+                                      ((tk[3] << (2 * c)) & (m << (2 * c))) | (tk[2] & (m << (3 * c))));
+        tk[2] = tk[0];
+        tk[3] = tk[1];
+        tk[0] = r0;
+        tk[1] = r1;
+    }
+
+    static inline void inv_permute_tweakey_rows(row_t tk[4])
+    {
+        // Q inverse: the two lower rows move up, the two upper rows are shuffled back down
+        const int c = CELL_BITS;
+        const row_t m = CELL_MASK;
+        row_t r2 = static_cast<row_t>(((tk[0] >> (2 * c)) & m) | ((tk[0] << c) & (m << c)) |
+                                      ((tk[1] << (2 * c)) & (m << (2 * c))) | (tk[1] & (m << (3 * c))));
+        row_t r3 = static_cast<row_t>(((tk[1] >> (2 * c)) & m) | ((tk[0] >> (2 * c)) & (m << c)) |
+                                      ((tk[1] << c) & (m << (2 * c))) | ((tk[0] << (2 * c)) & (m << (3 * c))));
+        tk[0] = tk[2];
+        tk[1] = tk[3];
+        tk[2] = r2;
+        tk[3] = r3;
+    }
+
+    template <class Trace>
+    static inline void trace_cells(const Trace &trace, int round, TraceStep step, const uint8_t state[16])
+    {
+        if constexpr (Trace::ENABLED)
+            trace(round, step, 0, 1, reinterpret_cast<const uint8_t(*)[16]>(state));
+    }
+
+    __attribute__((always_inline)) static inline void enc_round(row_t s[4], const row_t rtk[2], row_t c0, row_t c1)
+    {
+        row_t tmp;
+        // SBox
+        s[0] = sub_cells_row(s[0]);
+        s[1] = sub_cells_row(s[1]);
+        s[2] = sub_cells_row(s[2]);
+        s[3] = sub_cells_row(s[3]);
+        // Add round tweakey and constants
+        s[0] ^= rtk[0] ^ c0;
+        s[1] ^= rtk[1] ^ c1;
+        s[2] ^= 0x2;
+        // Permute cells (rotate row i by i cells)
+        s[1] = rotl_row(s[1], 1);
+        s[2] = rotl_row(s[2], 2);
+        s[3] = rotl_row(s[3], 3);
+        // MixColumn
+        s[1] ^= s[2];
+        s[2] ^= s[0];
+        s[3] ^= s[2];
+        tmp = s[3];
+        s[3] = s[2];
+        s[2] = s[1];
+        s[1] = s[0];
+        s[0] = tmp;
+    }
+
+    __attribute__((always_inline)) static inline void dec_round(row_t s[4], const row_t rtk[2], row_t c0, row_t c1)
+    {
+        row_t tmp;
+        // MixColumn inverse
+        tmp = s[0];
+        s[0] = s[1];
+        s[1] = s[2];
+        s[2] = s[3];
+        s[3] = tmp;
+        s[3] ^= s[2];
+        s[2] ^= s[0];
+        s[1] ^= s[2];
+        // Permute cells inverse
+        s[1] = rotl_row(s[1], 3);
+        s[2] = rotl_row(s[2], 2);
+        s[3] = rotl_row(s[3], 1);
+        // Add round tweakey and constants
+        s[0] ^= rtk[0] ^ c0;
+        s[1] ^= rtk[1] ^ c1;
+        s[2] ^= 0x2;
+        // SBox inverse
+        s[0] = inv_sub_cells_row(s[0]);
+        s[1] = inv_sub_cells_row(s[1]);
+        s[2] = inv_sub_cells_row(s[2]);
+        s[3] = inv_sub_cells_row(s[3]);
+    }
+};
+
+typedef Skinny<64, 64> Skinny64_64;
+typedef Skinny<64, 128> Skinny64_128;
+typedef Skinny<64, 192> Skinny64_192;
+typedef Skinny<128, 128> Skinny128_128;
+typedef Skinny<128, 256> Skinny128_256;
+typedef Skinny<128, 384> Skinny128_384;
+// Skinny-128-384+: the 40-round variant used by Romulus v1.3
+typedef Skinny<128, 384, 40> Skinny128_384_plus;
+
+} // namespace skinny
+
+#endif
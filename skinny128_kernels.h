@@ -0,0 +1,1238 @@
+/*
+ * Multi-block and single-block kernels for Skinny-128 (Skinny-128-128/256/384)
+ * Date: Oct 17, 2026
+*/
+// Every kernel takes the round tweakeys produced by Skinny<128, T>::tweakey_schedule(),
+// so the same kernels serve all three tweakey sizes.
+
+#ifndef SKINNY128_KERNELS_H
+#define SKINNY128_KERNELS_H
+
+#include "skinny.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace skinny
+{
+namespace kernels128
+{
+
+// T-tables: te[i][v] is S8[v] placed in every row of the column word that MixColumn feeds
+// from row i (byte k = row k), td[i][v] the same for S8inv and the inverse MixColumn.
+struct TTables
+{
+    uint32_t te[4][256];
+    uint32_t td[4][256];
+};
+
+constexpr TTables make_ttables()
+{
+    // Columns of the MixColumn matrix and of its inverse (bit k = output row k)
+    const uint8_t mc_col[4] = {0xb, 0x4, 0xd, 0x1};
+    const uint8_t inv_mc_col[4] = {0x8, 0x7, 0x2, 0xe};
+    TTables t{};
+    for (int i = 0; i < 4; i++)
+        for (int v = 0; v < 256; v++)
+            for (int k = 0; k < 4; k++)
+            {
+                if ((mc_col[i] >> k) & 0x1)
+                    t.te[i][v] |= (uint32_t)S8[v] << (8 * k);
+                if ((inv_mc_col[i] >> k) & 0x1)
+                    t.td[i][v] |= (uint32_t)S8inv[v] << (8 * k);
+            }
+    return t;
+}
+
+inline constexpr TTables TT = make_ttables();
+
+inline void tweakey_schedule_ttable(int rounds, const uint8_t round_tweakey[][8], uint32_t rk[][4])
+{
+    // Round tweakey and constants passed through the cell permutation and MixColumn,
+    // as column words (byte k = row k), so that a round is T(x) ^ rk[r]
+    uint8_t cells[16];
+    uint8_t temp[16];
+    for (int r = 0; r < rounds; r++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            temp[i] = (i < 8) ? round_tweakey[r][i] : 0;
+        temp[0] ^= (RC[r] & 0xf);
+        temp[4] ^= ((RC[r] >> 4) & 0x3);
+        temp[8] ^= 0x2;
+        for (uint8_t i = 0; i < 16; i++)
+            cells[i] = temp[P[i]];
+        mix_columns(cells);
+        for (uint8_t c = 0; c < 4; c++)
+            rk[r][c] = cells[c] | (cells[4 + c] << 8) | (cells[8 + c] << 16) | ((uint32_t)cells[12 + c] << 24);
+    }
+}
+
+inline void tweakey_schedule_ttable_inv(int rounds, const uint8_t round_tweakey[][8], uint32_t rk[][4])
+{
+    // Round tweakey and constants in the diagonal words used by dec_ttable():
+    // byte k of word w holds the cell in row k and column (w - k) mod 4
+    uint8_t cells[16];
+    for (int r = 0; r < rounds; r++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            cells[i] = (i < 8) ? round_tweakey[r][i] : 0;
+        cells[0] ^= (RC[r] & 0xf);
+        cells[4] ^= ((RC[r] >> 4) & 0x3);
+        cells[8] ^= 0x2;
+        for (uint8_t w = 0; w < 4; w++)
+        {
+            rk[r][w] = 0;
+            for (uint8_t k = 0; k < 4; k++)
+                rk[r][w] |= (uint32_t)cells[4 * k + ((w - k) & 0x3)] << (8 * k);
+        }
+    }
+}
+
+inline void enc_ttable(int R, const uint8_t plaintext[16], uint8_t ciphertext[16], const uint32_t rk[][4])
+{
+    // Not constant-time: table indices depend on the state
+    uint32_t x[4], y[4];
+    for (uint8_t c = 0; c < 4; c++)
+        x[c] = plaintext[c] | (plaintext[4 + c] << 8) | (plaintext[8 + c] << 16) | ((uint32_t)plaintext[12 + c] << 24);
+    for (int r = 0; r < R; r++)
+    {
+        // Cell (i, c) moves to column c + i and is spread over that column by MixColumn
+        y[0] = rk[r][0] ^ TT.te[0][x[0] & 0xff] ^ TT.te[1][(x[3] >> 8) & 0xff] ^ TT.te[2][(x[2] >> 16) & 0xff] ^ TT.te[3][x[1] >> 24];
+        y[1] = rk[r][1] ^ TT.te[0][x[1] & 0xff] ^ TT.te[1][(x[0] >> 8) & 0xff] ^ TT.te[2][(x[3] >> 16) & 0xff] ^ TT.te[3][x[2] >> 24];
+        y[2] = rk[r][2] ^ TT.te[0][x[2] & 0xff] ^ TT.te[1][(x[1] >> 8) & 0xff] ^ TT.te[2][(x[0] >> 16) & 0xff] ^ TT.te[3][x[3] >> 24];
+        y[3] = rk[r][3] ^ TT.te[0][x[3] & 0xff] ^ TT.te[1][(x[2] >> 8) & 0xff] ^ TT.te[2][(x[1] >> 16) & 0xff] ^ TT.te[3][x[0] >> 24];
+        for (uint8_t c = 0; c < 4; c++)
+            x[c] = y[c];
+    }
+    for (uint8_t i = 0; i < 16; i++)
+        ciphertext[i] = static_cast<uint8_t>(x[i & 0x3] >> (8 * (i >> 2)));
+}
+
+inline void dec_ttable(int R, uint8_t plaintext[16], const uint8_t ciphertext[16], const uint32_t rk[][4])
+{
+    // rk comes from tweakey_schedule_ttable_inv(). Each table round computes
+    // Pinv(MCinv(Sinv(x ^ rk[r]))); words are diagonals (see tweakey_schedule_ttable_inv())
+    uint8_t cells[16];
+    uint8_t temp[16];
+    uint32_t x[4], y[4];
+    for (uint8_t i = 0; i < 16; i++)
+        temp[i] = ciphertext[i];
+    inv_mix_columns(temp);
+    for (uint8_t i = 0; i < 16; i++)
+        cells[i] = temp[Pinv[i]];
+    for (uint8_t w = 0; w < 4; w++)
+    {
+        x[w] = 0;
+        for (uint8_t k = 0; k < 4; k++)
+            x[w] |= (uint32_t)cells[4 * k + ((w - k) & 0x3)] << (8 * k);
+    }
+    for (int r = R - 1; r > 0; r--)
+    {
+        for (uint8_t w = 0; w < 4; w++)
+            x[w] ^= rk[r][w];
+        // Cell (i, c) sits in byte i of word c + i and feeds word c
+        y[0] = TT.td[0][x[0] & 0xff] ^ TT.td[1][(x[1] >> 8) & 0xff] ^ TT.td[2][(x[2] >> 16) & 0xff] ^ TT.td[3][x[3] >> 24];
+        y[1] = TT.td[0][x[1] & 0xff] ^ TT.td[1][(x[2] >> 8) & 0xff] ^ TT.td[2][(x[3] >> 16) & 0xff] ^ TT.td[3][x[0] >> 24];
+        y[2] = TT.td[0][x[2] & 0xff] ^ TT.td[1][(x[3] >> 8) & 0xff] ^ TT.td[2][(x[0] >> 16) & 0xff] ^ TT.td[3][x[1] >> 24];
+        y[3] = TT.td[0][x[3] & 0xff] ^ TT.td[1][(x[0] >> 8) & 0xff] ^ TT.td[2][(x[1] >> 16) & 0xff] ^ TT.td[3][x[2] >> 24];
+        for (uint8_t w = 0; w < 4; w++)
+            x[w] = y[w];
+    }
+    // Last round: tweakey and constants, then SBox inverse
+    for (uint8_t w = 0; w < 4; w++)
+        x[w] ^= rk[0][w];
+    for (uint8_t i = 0; i < 16; i++)
+        plaintext[i] = S8inv[(x[((i & 0x3) + (i >> 2)) & 0x3] >> (8 * (i >> 2))) & 0xff];
+}
+
+// Fixsliced representation: bit-plane b of a word_t holds bit b of every cell of
+// sizeof(word_t) / 2 blocks. Cell (row, col) of block j sits at bit 4k*col + k*slot + j
+// (k = blocks per word), where the physical slot and column of each row drift from
+// round to round instead of applying ShiftRows. The drift repeats every four rounds,
+// so MixColumns comes in four variants whose rotations also realign the rows.
+// FS_MC[t][n] = {rotation in cells, destination slot} of the n-th row XOR in round 4q + t
+inline constexpr uint8_t FS_MC[4][3][2] = {{{13, 1}, {6, 2}, {3, 3}},
+                                {{9, 0}, {2, 1}, {7, 2}},
+                                {{1, 3}, {10, 0}, {11, 1}},
+                                {{1, 2}, {14, 3}, {3, 0}}};
+
+template <typename word_t>
+inline word_t ror_fixsliced(word_t x, int s)
+{
+    const int bits = 8 * sizeof(word_t);
+    return (x >> s) | (x << ((bits - s) & (bits - 1)));
+}
+
+template <typename word_t>
+inline word_t slot_mask_fixsliced(int slot)
+{
+    // k consecutive ones repeated in every column group of 4k bits
+    const int k = sizeof(word_t) / 2;
+    word_t m = (word_t)(~(word_t)0) / (((word_t)1 << (4 * k)) - 1) * (((word_t)1 << k) - 1);
+    return m << (k * slot);
+}
+
+inline void fixsliced_layout(int rounds, uint8_t offset[4])
+{
+    // Column offset of every slot at the beginning of the given round. Slot p holds
+    // logical row (p + r) % 4 in round r and ShiftRows moves the row it holds.
+    for (uint8_t p = 0; p < 4; p++)
+        offset[p] = 0;
+    for (int r = 0; r < rounds; r++)
+        for (uint8_t p = 0; p < 4; p++)
+            offset[p] = (offset[p] + 4 - ((p + r) & 0x3)) & 0x3;
+}
+
+template <typename word_t>
+inline void pack_fixsliced(const uint8_t blocks[][16], word_t state[8], int rounds)
+{
+    const int k = sizeof(word_t) / 2;
+    uint8_t offset[4];
+    int slot, pos;
+    fixsliced_layout(rounds, offset);
+    for (uint8_t b = 0; b < 8; b++)
+        state[b] = 0;
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        slot = ((i >> 2) + 4 - (rounds & 0x3)) & 0x3;
+        pos = 4 * k * (((i & 0x3) + offset[slot]) & 0x3) + k * slot;
+        for (int j = 0; j < k; j++)
+            for (uint8_t b = 0; b < 8; b++)
+                state[b] |= (word_t)((blocks[j][i] >> b) & 0x1) << (pos + j);
+    }
+}
+
+template <typename word_t>
+inline void unpack_fixsliced(const word_t state[8], uint8_t blocks[][16], int rounds)
+{
+    const int k = sizeof(word_t) / 2;
+    uint8_t offset[4];
+    int slot, pos;
+    fixsliced_layout(rounds, offset);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        slot = ((i >> 2) + 4 - (rounds & 0x3)) & 0x3;
+        pos = 4 * k * (((i & 0x3) + offset[slot]) & 0x3) + k * slot;
+        for (int j = 0; j < k; j++)
+        {
+            blocks[j][i] = 0;
+            for (uint8_t b = 0; b < 8; b++)
+                blocks[j][i] |= static_cast<uint8_t>(((state[b] >> (pos + j)) & 0x1) << b);
+        }
+    }
+}
+
+template <typename word_t>
+inline void tweakey_schedule_fixsliced(int rounds, const uint8_t round_tweakey[][8], word_t rtk_fs[][8])
+{
+    // Pre-pack round tweakeys and round constants into the layout of each round
+    const int k = sizeof(word_t) / 2;
+    const word_t lanes = ((word_t)1 << k) - 1;
+    uint8_t offset[4] = {0, 0, 0, 0};
+    uint8_t cell[12];
+    int slot, pos;
+    for (int r = 0; r < rounds; r++)
+    {
+        for (uint8_t i = 0; i < 12; i++)
+            cell[i] = (i < 8) ? round_tweakey[r][i] : 0;
+        cell[0] ^= (RC[r] & 0xf);
+        cell[4] ^= ((RC[r] >> 4) & 0x3);
+        cell[8] ^= 0x2;
+        for (uint8_t b = 0; b < 8; b++)
+            rtk_fs[r][b] = 0;
+        for (uint8_t i = 0; i < 12; i++)
+        {
+            slot = ((i >> 2) + 4 - (r & 0x3)) & 0x3;
+            pos = 4 * k * (((i & 0x3) + offset[slot]) & 0x3) + k * slot;
+            for (uint8_t b = 0; b < 8; b++)
+                rtk_fs[r][b] |= (-(word_t)((cell[i] >> b) & 0x1) & lanes) << pos;
+        }
+        for (uint8_t p = 0; p < 4; p++)
+            offset[p] = (offset[p] + 4 - ((p + r) & 0x3)) & 0x3;
+    }
+}
+
+template <typename word_t>
+inline void sbox_fixsliced(word_t x[8])
+{
+    // x[0] is the least significant bit of the cell
+    word_t t[8];
+    for (uint8_t n = 0; n < 3; n++)
+    {
+        x[4] ^= ~(x[7] | x[6]);
+        x[0] ^= ~(x[3] | x[2]);
+        // Bit permutation (x2, x1, x7, x6, x4, x0, x3, x5)
+        for (uint8_t b = 0; b < 8; b++)
+            t[b] = x[b];
+        x[7] = t[2];
+        x[6] = t[1];
+        x[5] = t[7];
+        x[4] = t[6];
+        x[3] = t[4];
+        x[2] = t[0];
+        x[1] = t[3];
+        x[0] = t[5];
+    }
+    x[4] ^= ~(x[7] | x[6]);
+    x[0] ^= ~(x[3] | x[2]);
+    t[0] = x[1];
+    x[1] = x[2];
+    x[2] = t[0];
+}
+
+template <typename word_t>
+inline void inv_sbox_fixsliced(word_t x[8])
+{
+    word_t t[8];
+    t[0] = x[1];
+    x[1] = x[2];
+    x[2] = t[0];
+    x[4] ^= ~(x[7] | x[6]);
+    x[0] ^= ~(x[3] | x[2]);
+    for (uint8_t n = 0; n < 3; n++)
+    {
+        for (uint8_t b = 0; b < 8; b++)
+            t[b] = x[b];
+        x[2] = t[7];
+        x[1] = t[6];
+        x[7] = t[5];
+        x[6] = t[4];
+        x[4] = t[3];
+        x[0] = t[2];
+        x[3] = t[1];
+        x[5] = t[0];
+        x[4] ^= ~(x[7] | x[6]);
+        x[0] ^= ~(x[3] | x[2]);
+    }
+}
+
+template <typename word_t>
+inline void mix_columns_fixsliced(word_t state[8], int t)
+{
+    // ShiftRows is absorbed into the rotations, the row rotation into the slot relabeling
+    const int k = sizeof(word_t) / 2;
+    for (uint8_t b = 0; b < 8; b++)
+        for (uint8_t n = 0; n < 3; n++)
+            state[b] ^= ror_fixsliced(state[b], k * FS_MC[t][n][0]) & slot_mask_fixsliced<word_t>(FS_MC[t][n][1]);
+}
+
+template <typename word_t>
+inline void inv_mix_columns_fixsliced(word_t state[8], int t)
+{
+    const int k = sizeof(word_t) / 2;
+    for (uint8_t b = 0; b < 8; b++)
+        for (int n = 2; n >= 0; n--)
+            state[b] ^= ror_fixsliced(state[b], k * FS_MC[t][n][0]) & slot_mask_fixsliced<word_t>(FS_MC[t][n][1]);
+}
+
+template <typename word_t>
+inline void enc_fixsliced(int R, const uint8_t plaintext[][16], uint8_t ciphertext[][16], const word_t rtk_fs[][8])
+{
+    // Encrypts sizeof(word_t) / 2 blocks at once (2 for uint32_t, 4 for uint64_t)
+    word_t state[8];
+    pack_fixsliced(plaintext, state, 0);
+    for (int r = 0; r < R; r++)
+    {
+        // SBox
+        sbox_fixsliced(state);
+        // Add constants and round tweakey (both pre-packed into rtk_fs)
+        for (uint8_t b = 0; b < 8; b++)
+            state[b] ^= rtk_fs[r][b];
+        // Permute cells and MixColumn
+        mix_columns_fixsliced(state, r & 0x3);
+    }
+    unpack_fixsliced(state, ciphertext, R);
+}
+
+template <typename word_t>
+inline void dec_fixsliced(int R, uint8_t plaintext[][16], const uint8_t ciphertext[][16], const word_t rtk_fs[][8])
+{
+    word_t state[8];
+    pack_fixsliced(ciphertext, state, R);
+    for (int r = R - 1; r >= 0; r--)
+    {
+        // MixColumn and cell permutation inverse
+        inv_mix_columns_fixsliced(state, r & 0x3);
+        // Add round tweakey and constants
+        for (uint8_t b = 0; b < 8; b++)
+            state[b] ^= rtk_fs[r][b];
+        // SBox inverse
+        inv_sbox_fixsliced(state);
+    }
+    unpack_fixsliced(state, plaintext, 0);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Cell permutation on bitsliced states: only the pointers move
+template <typename T>
+inline void permute_cells(T *cell[16], const uint8_t perm[16])
+{
+    T *temp[16];
+    for (uint8_t i = 0; i < 16; i++)
+        temp[i] = cell[i];
+    for (uint8_t i = 0; i < 16; i++)
+        cell[i] = temp[perm[i]];
+}
+
+// AVX2 bitsliced: 256 blocks, one __m256i per state bit
+__attribute__((target("avx2"))) inline void pack_bitsliced_avx2(const uint8_t blocks[256][16], __m256i state[16][8])
+{
+    // Bit b of cell i of block j goes to bit j of state[i][b]. Every group of 32 blocks is
+    // transposed to byte-sliced order first, then movemask extracts one bit-plane at a time.
+    alignas(32) uint32_t planes[16][8][8];
+    alignas(32) uint8_t bytes[16][32];
+    __m256i v;
+    for (uint8_t g = 0; g < 8; g++)
+    {
+        for (uint8_t j = 0; j < 32; j++)
+            for (uint8_t i = 0; i < 16; i++)
+                bytes[i][j] = blocks[32 * g + j][i];
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            v = _mm256_load_si256((const __m256i *)bytes[i]);
+            for (uint8_t b = 0; b < 8; b++)
+                planes[i][b][g] = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi64(v, 7 - b)));
+        }
+    }
+    for (uint8_t i = 0; i < 16; i++)
+        for (uint8_t b = 0; b < 8; b++)
+            state[i][b] = _mm256_load_si256((const __m256i *)planes[i][b]);
+}
+
+__attribute__((target("avx2"))) inline void unpack_bitsliced_avx2(__m256i *state[16], uint8_t blocks[256][16])
+{
+    // Spreads 32 bits of a bit-plane over 32 bytes and merges the eight planes of a cell
+    alignas(32) uint32_t planes[16][8][8];
+    alignas(32) uint8_t bytes[16][32];
+    const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                            2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i select = _mm256_set1_epi64x(0x8040201008040201ULL);
+    __m256i v, acc;
+    for (uint8_t i = 0; i < 16; i++)
+        for (uint8_t b = 0; b < 8; b++)
+            _mm256_store_si256((__m256i *)planes[i][b], state[i][b]);
+    for (uint8_t g = 0; g < 8; g++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            acc = _mm256_setzero_si256();
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                v = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(planes[i][b][g])), spread);
+                v = _mm256_cmpeq_epi8(_mm256_and_si256(v, select), select);
+                acc = _mm256_or_si256(acc, _mm256_and_si256(v, _mm256_set1_epi8(static_cast<char>(1 << b))));
+            }
+            _mm256_store_si256((__m256i *)bytes[i], acc);
+        }
+        for (uint8_t j = 0; j < 32; j++)
+            for (uint8_t i = 0; i < 16; i++)
+                blocks[32 * g + j][i] = bytes[i][j];
+    }
+}
+
+__attribute__((target("avx2"))) inline void sbox_bitsliced_avx2(__m256i x[8])
+{
+    // Four NOR/XOR layers, the bit permutations between them are register renaming
+    const __m256i ones = _mm256_set1_epi32(-1);
+    __m256i t[8];
+    for (uint8_t n = 0; n < 3; n++)
+    {
+        x[4] = _mm256_xor_si256(x[4], _mm256_xor_si256(_mm256_or_si256(x[7], x[6]), ones));
+        x[0] = _mm256_xor_si256(x[0], _mm256_xor_si256(_mm256_or_si256(x[3], x[2]), ones));
+        for (uint8_t b = 0; b < 8; b++)
+            t[b] = x[b];
+        x[7] = t[2];
+        x[6] = t[1];
+        x[5] = t[7];
+        x[4] = t[6];
+        x[3] = t[4];
+        x[2] = t[0];
+        x[1] = t[3];
+        x[0] = t[5];
+    }
+    x[4] = _mm256_xor_si256(x[4], _mm256_xor_si256(_mm256_or_si256(x[7], x[6]), ones));
+    x[0] = _mm256_xor_si256(x[0], _mm256_xor_si256(_mm256_or_si256(x[3], x[2]), ones));
+    t[0] = x[1];
+    x[1] = x[2];
+    x[2] = t[0];
+}
+
+__attribute__((target("avx2"))) inline void inv_sbox_bitsliced_avx2(__m256i x[8])
+{
+    const __m256i ones = _mm256_set1_epi32(-1);
+    __m256i t[8];
+    t[0] = x[1];
+    x[1] = x[2];
+    x[2] = t[0];
+    x[4] = _mm256_xor_si256(x[4], _mm256_xor_si256(_mm256_or_si256(x[7], x[6]), ones));
+    x[0] = _mm256_xor_si256(x[0], _mm256_xor_si256(_mm256_or_si256(x[3], x[2]), ones));
+    for (uint8_t n = 0; n < 3; n++)
+    {
+        for (uint8_t b = 0; b < 8; b++)
+            t[b] = x[b];
+        x[2] = t[7];
+        x[1] = t[6];
+        x[7] = t[5];
+        x[6] = t[4];
+        x[4] = t[3];
+        x[0] = t[2];
+        x[3] = t[1];
+        x[5] = t[0];
+        x[4] = _mm256_xor_si256(x[4], _mm256_xor_si256(_mm256_or_si256(x[7], x[6]), ones));
+        x[0] = _mm256_xor_si256(x[0], _mm256_xor_si256(_mm256_or_si256(x[3], x[2]), ones));
+    }
+}
+
+__attribute__((target("avx2"))) inline void add_round_tweakey_avx2(__m256i *cell[16], int r, const uint8_t tk[][8])
+{
+    // Every set bit of the round tweakey or constant complements a whole bit-plane
+    uint8_t rk[12];
+    for (uint8_t i = 0; i < 12; i++)
+        rk[i] = (i < 8) ? tk[r][i] : 0;
+    rk[0] ^= (RC[r] & 0xf);
+    rk[4] ^= ((RC[r] >> 4) & 0x3);
+    rk[8] ^= 0x2;
+    for (uint8_t i = 0; i < 12; i++)
+        for (uint8_t b = 0; b < 8; b++)
+            cell[i][b] = _mm256_xor_si256(cell[i][b], _mm256_set1_epi32(-static_cast<int>((rk[i] >> b) & 0x1)));
+}
+
+__attribute__((target("avx2"))) inline void add_tk1_avx2(__m256i *cell[16], __m256i *tk1_cell[16])
+{
+    for (uint8_t i = 0; i < 8; i++)
+        for (uint8_t b = 0; b < 8; b++)
+            cell[i][b] = _mm256_xor_si256(cell[i][b], tk1_cell[i][b]);
+}
+
+// The 256 states in cells for a trace policy (see NoTrace); constants: with the round
+// constants added, as constants and round tweakey are added in one go
+template <class Trace>
+__attribute__((target("avx2"))) inline void trace_bitsliced_avx2(const Trace &trace, int round, TraceStep step, __m256i *cell[16], bool constants = false)
+{
+    if constexpr (Trace::ENABLED)
+    {
+        uint8_t blocks[256][16];
+        unpack_bitsliced_avx2(cell, blocks);
+        if (constants)
+            for (size_t j = 0; j < 256; j++)
+                add_constants_cells(round, blocks[j]);
+        trace(round, step, 0, 256, blocks);
+    }
+}
+
+template <class Trace = NoTrace>
+__attribute__((target("avx2"))) inline void enc_bitsliced_avx2(int R, const uint8_t plaintext[256][16], uint8_t ciphertext[256][16], const uint8_t tk[][8], const uint8_t tk1[][16] = NULL, const Trace &trace = Trace())
+{
+    // Encrypts 256 blocks at once, bit j of every bit-plane belongs to block j. cell[i]
+    // points to the eight bit-planes of cell i, so cell permutations only move pointers.
+    // With tk1, every block has its own TK1 and tk holds the round tweakeys of the other
+    // lanes (TK1 = 0). TK1 only goes through Q, so it is bitsliced once and moved by pointers.
+    __m256i state[16][8], tk1_state[16][8];
+    __m256i *cell[16], *temp[16], *tmp, *tk1_cell[16];
+    pack_bitsliced_avx2(plaintext, state);
+    if (tk1 != NULL)
+        pack_bitsliced_avx2(tk1, tk1_state);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        cell[i] = state[i];
+        tk1_cell[i] = tk1_state[i];
+    }
+    for (int r = 0; r < R; r++)
+    {
+        // SBox
+        for (uint8_t i = 0; i < 16; i++)
+            sbox_bitsliced_avx2(cell[i]);
+        trace_bitsliced_avx2(trace, r, TRACE_SUB_CELLS, cell);
+        trace_bitsliced_avx2(trace, r, TRACE_ADD_CONSTANTS, cell, true);
+        // Add constants and round tweakey
+        add_round_tweakey_avx2(cell, r, tk);
+        if (tk1 != NULL)
+        {
+            add_tk1_avx2(cell, tk1_cell);
+            permute_cells(tk1_cell, Q);
+        }
+        trace_bitsliced_avx2(trace, r, TRACE_ADD_ROUND_TWEAKEY, cell);
+        // Permute cells
+        for (uint8_t i = 0; i < 16; i++)
+            temp[i] = cell[i];
+        for (uint8_t i = 0; i < 16; i++)
+            cell[i] = temp[P[i]];
+        trace_bitsliced_avx2(trace, r, TRACE_SHIFT_ROWS, cell);
+        // MixColumn
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                cell[j + 4 * 1][b] = _mm256_xor_si256(cell[j + 4 * 1][b], cell[j + 4 * 2][b]);
+                cell[j + 4 * 2][b] = _mm256_xor_si256(cell[j + 4 * 2][b], cell[j + 4 * 0][b]);
+                cell[j + 4 * 3][b] = _mm256_xor_si256(cell[j + 4 * 3][b], cell[j + 4 * 2][b]);
+            }
+            tmp = cell[j + 4 * 3];
+            cell[j + 4 * 3] = cell[j + 4 * 2];
+            cell[j + 4 * 2] = cell[j + 4 * 1];
+            cell[j + 4 * 1] = cell[j + 4 * 0];
+            cell[j + 4 * 0] = tmp;
+        }
+        trace_bitsliced_avx2(trace, r, TRACE_MIX_COLUMNS, cell);
+    }
+    unpack_bitsliced_avx2(cell, ciphertext);
+}
+
+template <class Trace = NoTrace>
+__attribute__((target("avx2"))) inline void dec_bitsliced_avx2(int R, uint8_t plaintext[256][16], const uint8_t ciphertext[256][16], const uint8_t tk[][8], const uint8_t tk1[][16] = NULL, const Trace &trace = Trace())
+{
+    __m256i state[16][8], tk1_state[16][8];
+    __m256i *cell[16], *temp[16], *tmp, *tk1_cell[16];
+    pack_bitsliced_avx2(ciphertext, state);
+    if (tk1 != NULL)
+        pack_bitsliced_avx2(tk1, tk1_state);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        cell[i] = state[i];
+        tk1_cell[i] = tk1_state[i];
+    }
+    // TK1 of the last round
+    if (tk1 != NULL)
+        for (int r = 0; r < R - 1; r++)
+            permute_cells(tk1_cell, Q);
+    for (int r = R - 1; r >= 0; r--)
+    {
+        // MixColumn inverse
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            tmp = cell[j + 4 * 3];
+            cell[j + 4 * 3] = cell[j + 4 * 0];
+            cell[j + 4 * 0] = cell[j + 4 * 1];
+            cell[j + 4 * 1] = cell[j + 4 * 2];
+            cell[j + 4 * 2] = tmp;
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                cell[j + 4 * 3][b] = _mm256_xor_si256(cell[j + 4 * 3][b], cell[j + 4 * 2][b]);
+                cell[j + 4 * 2][b] = _mm256_xor_si256(cell[j + 4 * 2][b], cell[j + 4 * 0][b]);
+                cell[j + 4 * 1][b] = _mm256_xor_si256(cell[j + 4 * 1][b], cell[j + 4 * 2][b]);
+            }
+        }
+        trace_bitsliced_avx2(trace, r, TRACE_MIX_COLUMNS, cell);
+        // Permute cells inverse
+        for (uint8_t i = 0; i < 16; i++)
+            temp[i] = cell[i];
+        for (uint8_t i = 0; i < 16; i++)
+            cell[i] = temp[Pinv[i]];
+        trace_bitsliced_avx2(trace, r, TRACE_SHIFT_ROWS, cell);
+        // Add round tweakey and constants
+        add_round_tweakey_avx2(cell, r, tk);
+        if (tk1 != NULL)
+        {
+            add_tk1_avx2(cell, tk1_cell);
+            permute_cells(tk1_cell, Qinv);
+        }
+        trace_bitsliced_avx2(trace, r, TRACE_ADD_ROUND_TWEAKEY, cell, true);
+        trace_bitsliced_avx2(trace, r, TRACE_ADD_CONSTANTS, cell);
+        // SBox inverse
+        for (uint8_t i = 0; i < 16; i++)
+            inv_sbox_bitsliced_avx2(cell[i]);
+        trace_bitsliced_avx2(trace, r, TRACE_SUB_CELLS, cell);
+    }
+    unpack_bitsliced_avx2(cell, plaintext);
+}
+
+// Multi-key: every block has its own Lanes-lane tweakey, bitsliced like the state. Q only
+// moves the cell pointers of a lane, the TK2/TK3 LFSRs shift the eight planes of a cell
+// with one XOR.
+__attribute__((target("avx2"))) inline void tk2_lfsr_bitsliced_avx2(__m256i x[8])
+{
+    __m256i feedback = _mm256_xor_si256(x[7], x[5]);
+    for (uint8_t b = 7; b > 0; b--)
+        x[b] = x[b - 1];
+    x[0] = feedback;
+}
+
+__attribute__((target("avx2"))) inline void tk3_lfsr_bitsliced_avx2(__m256i x[8])
+{
+    __m256i feedback = _mm256_xor_si256(x[0], x[6]);
+    for (uint8_t b = 0; b < 7; b++)
+        x[b] = x[b + 1];
+    x[7] = feedback;
+}
+
+template <int Lanes>
+__attribute__((target("avx2"))) inline void pack_tweakey_avx2(const uint8_t tweakey[256][Lanes][16], __m256i t[Lanes][16][8])
+{
+    uint8_t lane[256][16];
+    for (int l = 0; l < Lanes; l++)
+    {
+        for (size_t j = 0; j < 256; j++)
+            memcpy(lane[j], tweakey[j][l], 16);
+        pack_bitsliced_avx2(lane, t[l]);
+    }
+}
+
+template <int Lanes>
+__attribute__((target("avx2"))) inline void next_tweakey_avx2(__m256i *tk_cell[Lanes][16])
+{
+    for (int l = 0; l < Lanes; l++)
+        permute_cells(tk_cell[l], Q);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if constexpr (Lanes > 1)
+            tk2_lfsr_bitsliced_avx2(tk_cell[1][i]);
+        if constexpr (Lanes > 2)
+            tk3_lfsr_bitsliced_avx2(tk_cell[Lanes - 1][i]);
+    }
+}
+
+template <int Lanes>
+__attribute__((target("avx2"))) inline void prev_tweakey_avx2(__m256i *tk_cell[Lanes][16])
+{
+    // The TK2 and TK3 LFSRs are each other's inverse
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if constexpr (Lanes > 1)
+            tk3_lfsr_bitsliced_avx2(tk_cell[1][i]);
+        if constexpr (Lanes > 2)
+            tk2_lfsr_bitsliced_avx2(tk_cell[Lanes - 1][i]);
+    }
+    for (int l = 0; l < Lanes; l++)
+        permute_cells(tk_cell[l], Qinv);
+}
+
+template <int Lanes>
+__attribute__((target("avx2"))) inline void add_tweakey_lanes_avx2(__m256i *cell[16], __m256i *tk_cell[Lanes][16])
+{
+    for (int l = 0; l < Lanes; l++)
+        add_tk1_avx2(cell, tk_cell[l]);
+}
+
+__attribute__((target("avx2"))) inline void add_constants_avx2(__m256i *cell[16], int r)
+{
+    const __m256i ones = _mm256_set1_epi32(-1);
+    for (uint8_t b = 0; b < 4; b++)
+        cell[0][b] = _mm256_xor_si256(cell[0][b], _mm256_set1_epi32(-static_cast<int>((RC[r] >> b) & 0x1)));
+    for (uint8_t b = 0; b < 2; b++)
+        cell[4][b] = _mm256_xor_si256(cell[4][b], _mm256_set1_epi32(-static_cast<int>((RC[r] >> (4 + b)) & 0x1)));
+    cell[8][1] = _mm256_xor_si256(cell[8][1], ones);
+}
+
+// tweakey[j] holds the lanes TK1, TK2, TK3 of block j
+template <int Lanes>
+__attribute__((target("avx2"))) inline void enc_bitsliced_multikey_avx2(int R, const uint8_t plaintext[256][16], uint8_t ciphertext[256][16], const uint8_t tweakey[256][Lanes][16])
+{
+    __m256i state[16][8], tk_state[Lanes][16][8];
+    __m256i *cell[16], *temp[16], *tmp, *tk_cell[Lanes][16];
+    pack_bitsliced_avx2(plaintext, state);
+    pack_tweakey_avx2<Lanes>(tweakey, tk_state);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        cell[i] = state[i];
+        for (int l = 0; l < Lanes; l++)
+            tk_cell[l][i] = tk_state[l][i];
+    }
+    for (int r = 0; r < R; r++)
+    {
+        if (r > 0)
+            next_tweakey_avx2<Lanes>(tk_cell);
+        // SBox
+        for (uint8_t i = 0; i < 16; i++)
+            sbox_bitsliced_avx2(cell[i]);
+        // Add constants and round tweakey
+        add_constants_avx2(cell, r);
+        add_tweakey_lanes_avx2<Lanes>(cell, tk_cell);
+        // Permute cells
+        for (uint8_t i = 0; i < 16; i++)
+            temp[i] = cell[i];
+        for (uint8_t i = 0; i < 16; i++)
+            cell[i] = temp[P[i]];
+        // MixColumn
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                cell[j + 4 * 1][b] = _mm256_xor_si256(cell[j + 4 * 1][b], cell[j + 4 * 2][b]);
+                cell[j + 4 * 2][b] = _mm256_xor_si256(cell[j + 4 * 2][b], cell[j + 4 * 0][b]);
+                cell[j + 4 * 3][b] = _mm256_xor_si256(cell[j + 4 * 3][b], cell[j + 4 * 2][b]);
+            }
+            tmp = cell[j + 4 * 3];
+            cell[j + 4 * 3] = cell[j + 4 * 2];
+            cell[j + 4 * 2] = cell[j + 4 * 1];
+            cell[j + 4 * 1] = cell[j + 4 * 0];
+            cell[j + 4 * 0] = tmp;
+        }
+    }
+    unpack_bitsliced_avx2(cell, ciphertext);
+}
+
+template <int Lanes>
+__attribute__((target("avx2"))) inline void dec_bitsliced_multikey_avx2(int R, uint8_t plaintext[256][16], const uint8_t ciphertext[256][16], const uint8_t tweakey[256][Lanes][16])
+{
+    __m256i state[16][8], tk_state[Lanes][16][8];
+    __m256i *cell[16], *temp[16], *tmp, *tk_cell[Lanes][16];
+    pack_bitsliced_avx2(ciphertext, state);
+    pack_tweakey_avx2<Lanes>(tweakey, tk_state);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        cell[i] = state[i];
+        for (int l = 0; l < Lanes; l++)
+            tk_cell[l][i] = tk_state[l][i];
+    }
+    // Tweakey of the last round, then stepped back round by round
+    for (int r = 0; r < R - 1; r++)
+        next_tweakey_avx2<Lanes>(tk_cell);
+    for (int r = R - 1; r >= 0; r--)
+    {
+        if (r < R - 1)
+            prev_tweakey_avx2<Lanes>(tk_cell);
+        // MixColumn inverse
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            tmp = cell[j + 4 * 3];
+            cell[j + 4 * 3] = cell[j + 4 * 0];
+            cell[j + 4 * 0] = cell[j + 4 * 1];
+            cell[j + 4 * 1] = cell[j + 4 * 2];
+            cell[j + 4 * 2] = tmp;
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                cell[j + 4 * 3][b] = _mm256_xor_si256(cell[j + 4 * 3][b], cell[j + 4 * 2][b]);
+                cell[j + 4 * 2][b] = _mm256_xor_si256(cell[j + 4 * 2][b], cell[j + 4 * 0][b]);
+                cell[j + 4 * 1][b] = _mm256_xor_si256(cell[j + 4 * 1][b], cell[j + 4 * 2][b]);
+            }
+        }
+        // Permute cells inverse
+        for (uint8_t i = 0; i < 16; i++)
+            temp[i] = cell[i];
+        for (uint8_t i = 0; i < 16; i++)
+            cell[i] = temp[Pinv[i]];
+        // Add round tweakey and constants
+        add_tweakey_lanes_avx2<Lanes>(cell, tk_cell);
+        add_constants_avx2(cell, r);
+        // SBox inverse
+        for (uint8_t i = 0; i < 16; i++)
+            inv_sbox_bitsliced_avx2(cell[i]);
+    }
+    unpack_bitsliced_avx2(cell, plaintext);
+}
+
+// AVX-512 bitsliced: 512 blocks, one __m512i per state bit
+__attribute__((target("avx512f,avx512bw"))) inline void pack_bitsliced_avx512(const uint8_t blocks[512][16], __m512i state[16][8])
+{
+    // Bit b of cell i of block j goes to bit j of state[i][b], 64 blocks per test_epi8_mask
+    alignas(64) uint64_t planes[16][8][8];
+    alignas(64) uint8_t bytes[16][64];
+    __m512i v;
+    for (uint8_t g = 0; g < 8; g++)
+    {
+        for (uint8_t j = 0; j < 64; j++)
+            for (uint8_t i = 0; i < 16; i++)
+                bytes[i][j] = blocks[64 * g + j][i];
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            v = _mm512_load_si512((const void *)bytes[i]);
+            for (uint8_t b = 0; b < 8; b++)
+                planes[i][b][g] = _mm512_test_epi8_mask(v, _mm512_set1_epi8(static_cast<char>(1 << b)));
+        }
+    }
+    for (uint8_t i = 0; i < 16; i++)
+        for (uint8_t b = 0; b < 8; b++)
+            state[i][b] = _mm512_load_si512((const void *)planes[i][b]);
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void unpack_bitsliced_avx512(__m512i *state[16], uint8_t blocks[512][16])
+{
+    // movm_epi8 turns 64 bits of a bit-plane into 64 bytes of 0x00 or 0xff
+    alignas(64) uint64_t planes[16][8][8];
+    alignas(64) uint8_t bytes[16][64];
+    __m512i acc;
+    for (uint8_t i = 0; i < 16; i++)
+        for (uint8_t b = 0; b < 8; b++)
+            _mm512_store_si512((void *)planes[i][b], state[i][b]);
+    for (uint8_t g = 0; g < 8; g++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            acc = _mm512_setzero_si512();
+            for (uint8_t b = 0; b < 8; b++)
+                acc = _mm512_or_si512(acc, _mm512_and_si512(_mm512_movm_epi8(planes[i][b][g]), _mm512_set1_epi8(static_cast<char>(1 << b))));
+            _mm512_store_si512((void *)bytes[i], acc);
+        }
+        for (uint8_t j = 0; j < 64; j++)
+            for (uint8_t i = 0; i < 16; i++)
+                blocks[64 * g + j][i] = bytes[i][j];
+    }
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void sbox_bitsliced_avx512(__m512i x[8])
+{
+    // x ^= ~(a | b) is a single vpternlog (truth table 0xe1)
+    __m512i t[8];
+    for (uint8_t n = 0; n < 3; n++)
+    {
+        x[4] = _mm512_ternarylogic_epi64(x[4], x[7], x[6], 0xe1);
+        x[0] = _mm512_ternarylogic_epi64(x[0], x[3], x[2], 0xe1);
+        for (uint8_t b = 0; b < 8; b++)
+            t[b] = x[b];
+        x[7] = t[2];
+        x[6] = t[1];
+        x[5] = t[7];
+        x[4] = t[6];
+        x[3] = t[4];
+        x[2] = t[0];
+        x[1] = t[3];
+        x[0] = t[5];
+    }
+    x[4] = _mm512_ternarylogic_epi64(x[4], x[7], x[6], 0xe1);
+    x[0] = _mm512_ternarylogic_epi64(x[0], x[3], x[2], 0xe1);
+    t[0] = x[1];
+    x[1] = x[2];
+    x[2] = t[0];
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void inv_sbox_bitsliced_avx512(__m512i x[8])
+{
+    __m512i t[8];
+    t[0] = x[1];
+    x[1] = x[2];
+    x[2] = t[0];
+    x[4] = _mm512_ternarylogic_epi64(x[4], x[7], x[6], 0xe1);
+    x[0] = _mm512_ternarylogic_epi64(x[0], x[3], x[2], 0xe1);
+    for (uint8_t n = 0; n < 3; n++)
+    {
+        for (uint8_t b = 0; b < 8; b++)
+            t[b] = x[b];
+        x[2] = t[7];
+        x[1] = t[6];
+        x[7] = t[5];
+        x[6] = t[4];
+        x[4] = t[3];
+        x[0] = t[2];
+        x[3] = t[1];
+        x[5] = t[0];
+        x[4] = _mm512_ternarylogic_epi64(x[4], x[7], x[6], 0xe1);
+        x[0] = _mm512_ternarylogic_epi64(x[0], x[3], x[2], 0xe1);
+    }
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void add_round_tweakey_avx512(__m512i *cell[16], int r, const uint8_t tk[][8])
+{
+    uint8_t rk[12];
+    for (uint8_t i = 0; i < 12; i++)
+        rk[i] = (i < 8) ? tk[r][i] : 0;
+    rk[0] ^= (RC[r] & 0xf);
+    rk[4] ^= ((RC[r] >> 4) & 0x3);
+    rk[8] ^= 0x2;
+    for (uint8_t i = 0; i < 12; i++)
+        for (uint8_t b = 0; b < 8; b++)
+            cell[i][b] = _mm512_xor_si512(cell[i][b], _mm512_set1_epi32(-static_cast<int>((rk[i] >> b) & 0x1)));
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void add_tk1_avx512(__m512i *cell[16], __m512i *tk1_cell[16])
+{
+    for (uint8_t i = 0; i < 8; i++)
+        for (uint8_t b = 0; b < 8; b++)
+            cell[i][b] = _mm512_xor_si512(cell[i][b], tk1_cell[i][b]);
+}
+
+// The 512 states in cells for a trace policy (see NoTrace); constants: with the round
+// constants added, as constants and round tweakey are added in one go
+template <class Trace>
+__attribute__((target("avx512f,avx512bw"))) inline void trace_bitsliced_avx512(const Trace &trace, int round, TraceStep step, __m512i *cell[16], bool constants = false)
+{
+    if constexpr (Trace::ENABLED)
+    {
+        uint8_t blocks[512][16];
+        unpack_bitsliced_avx512(cell, blocks);
+        if (constants)
+            for (size_t j = 0; j < 512; j++)
+                add_constants_cells(round, blocks[j]);
+        trace(round, step, 0, 512, blocks);
+    }
+}
+
+template <class Trace = NoTrace>
+__attribute__((target("avx512f,avx512bw"))) inline void enc_bitsliced_avx512(int R, const uint8_t plaintext[512][16], uint8_t ciphertext[512][16], const uint8_t tk[][8], const uint8_t tk1[][16] = NULL, const Trace &trace = Trace())
+{
+    // Same structure as enc_bitsliced_avx2(), on twice as many blocks
+    __m512i state[16][8], tk1_state[16][8];
+    __m512i *cell[16], *temp[16], *tmp, *tk1_cell[16];
+    pack_bitsliced_avx512(plaintext, state);
+    if (tk1 != NULL)
+        pack_bitsliced_avx512(tk1, tk1_state);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        cell[i] = state[i];
+        tk1_cell[i] = tk1_state[i];
+    }
+    for (int r = 0; r < R; r++)
+    {
+        // SBox
+        for (uint8_t i = 0; i < 16; i++)
+            sbox_bitsliced_avx512(cell[i]);
+        trace_bitsliced_avx512(trace, r, TRACE_SUB_CELLS, cell);
+        trace_bitsliced_avx512(trace, r, TRACE_ADD_CONSTANTS, cell, true);
+        // Add constants and round tweakey
+        add_round_tweakey_avx512(cell, r, tk);
+        if (tk1 != NULL)
+        {
+            add_tk1_avx512(cell, tk1_cell);
+            permute_cells(tk1_cell, Q);
+        }
+        trace_bitsliced_avx512(trace, r, TRACE_ADD_ROUND_TWEAKEY, cell);
+        // Permute cells
+        for (uint8_t i = 0; i < 16; i++)
+            temp[i] = cell[i];
+        for (uint8_t i = 0; i < 16; i++)
+            cell[i] = temp[P[i]];
+        trace_bitsliced_avx512(trace, r, TRACE_SHIFT_ROWS, cell);
+        // MixColumn
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                cell[j + 4 * 1][b] = _mm512_xor_si512(cell[j + 4 * 1][b], cell[j + 4 * 2][b]);
+                cell[j + 4 * 2][b] = _mm512_xor_si512(cell[j + 4 * 2][b], cell[j + 4 * 0][b]);
+                cell[j + 4 * 3][b] = _mm512_xor_si512(cell[j + 4 * 3][b], cell[j + 4 * 2][b]);
+            }
+            tmp = cell[j + 4 * 3];
+            cell[j + 4 * 3] = cell[j + 4 * 2];
+            cell[j + 4 * 2] = cell[j + 4 * 1];
+            cell[j + 4 * 1] = cell[j + 4 * 0];
+            cell[j + 4 * 0] = tmp;
+        }
+        trace_bitsliced_avx512(trace, r, TRACE_MIX_COLUMNS, cell);
+    }
+    unpack_bitsliced_avx512(cell, ciphertext);
+}
+
+template <class Trace = NoTrace>
+__attribute__((target("avx512f,avx512bw"))) inline void dec_bitsliced_avx512(int R, uint8_t plaintext[512][16], const uint8_t ciphertext[512][16], const uint8_t tk[][8], const uint8_t tk1[][16] = NULL, const Trace &trace = Trace())
+{
+    __m512i state[16][8], tk1_state[16][8];
+    __m512i *cell[16], *temp[16], *tmp, *tk1_cell[16];
+    pack_bitsliced_avx512(ciphertext, state);
+    if (tk1 != NULL)
+        pack_bitsliced_avx512(tk1, tk1_state);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        cell[i] = state[i];
+        tk1_cell[i] = tk1_state[i];
+    }
+    // TK1 of the last round
+    if (tk1 != NULL)
+        for (int r = 0; r < R - 1; r++)
+            permute_cells(tk1_cell, Q);
+    for (int r = R - 1; r >= 0; r--)
+    {
+        // MixColumn inverse
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            tmp = cell[j + 4 * 3];
+            cell[j + 4 * 3] = cell[j + 4 * 0];
+            cell[j + 4 * 0] = cell[j + 4 * 1];
+            cell[j + 4 * 1] = cell[j + 4 * 2];
+            cell[j + 4 * 2] = tmp;
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                cell[j + 4 * 3][b] = _mm512_xor_si512(cell[j + 4 * 3][b], cell[j + 4 * 2][b]);
+                cell[j + 4 * 2][b] = _mm512_xor_si512(cell[j + 4 * 2][b], cell[j + 4 * 0][b]);
+                cell[j + 4 * 1][b] = _mm512_xor_si512(cell[j + 4 * 1][b], cell[j + 4 * 2][b]);
+            }
+        }
+        trace_bitsliced_avx512(trace, r, TRACE_MIX_COLUMNS, cell);
+        // Permute cells inverse
+        for (uint8_t i = 0; i < 16; i++)
+            temp[i] = cell[i];
+        for (uint8_t i = 0; i < 16; i++)
+            cell[i] = temp[Pinv[i]];
+        trace_bitsliced_avx512(trace, r, TRACE_SHIFT_ROWS, cell);
+        // Add round tweakey and constants
+        add_round_tweakey_avx512(cell, r, tk);
+        if (tk1 != NULL)
+        {
+            add_tk1_avx512(cell, tk1_cell);
+            permute_cells(tk1_cell, Qinv);
+        }
+        trace_bitsliced_avx512(trace, r, TRACE_ADD_ROUND_TWEAKEY, cell, true);
+        trace_bitsliced_avx512(trace, r, TRACE_ADD_CONSTANTS, cell);
+        // SBox inverse
+        for (uint8_t i = 0; i < 16; i++)
+            inv_sbox_bitsliced_avx512(cell[i]);
+        trace_bitsliced_avx512(trace, r, TRACE_SUB_CELLS, cell);
+    }
+    unpack_bitsliced_avx512(cell, plaintext);
+}
+
+// Multi-key AVX-512: the same on 512 blocks
+__attribute__((target("avx512f,avx512bw"))) inline void tk2_lfsr_bitsliced_avx512(__m512i x[8])
+{
+    __m512i feedback = _mm512_xor_si512(x[7], x[5]);
+    for (uint8_t b = 7; b > 0; b--)
+        x[b] = x[b - 1];
+    x[0] = feedback;
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void tk3_lfsr_bitsliced_avx512(__m512i x[8])
+{
+    __m512i feedback = _mm512_xor_si512(x[0], x[6]);
+    for (uint8_t b = 0; b < 7; b++)
+        x[b] = x[b + 1];
+    x[7] = feedback;
+}
+
+template <int Lanes>
+__attribute__((target("avx512f,avx512bw"))) inline void pack_tweakey_avx512(const uint8_t tweakey[512][Lanes][16], __m512i t[Lanes][16][8])
+{
+    uint8_t lane[512][16];
+    for (int l = 0; l < Lanes; l++)
+    {
+        for (size_t j = 0; j < 512; j++)
+            memcpy(lane[j], tweakey[j][l], 16);
+        pack_bitsliced_avx512(lane, t[l]);
+    }
+}
+
+template <int Lanes>
+__attribute__((target("avx512f,avx512bw"))) inline void next_tweakey_avx512(__m512i *tk_cell[Lanes][16])
+{
+    for (int l = 0; l < Lanes; l++)
+        permute_cells(tk_cell[l], Q);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if constexpr (Lanes > 1)
+            tk2_lfsr_bitsliced_avx512(tk_cell[1][i]);
+        if constexpr (Lanes > 2)
+            tk3_lfsr_bitsliced_avx512(tk_cell[Lanes - 1][i]);
+    }
+}
+
+template <int Lanes>
+__attribute__((target("avx512f,avx512bw"))) inline void prev_tweakey_avx512(__m512i *tk_cell[Lanes][16])
+{
+    // The TK2 and TK3 LFSRs are each other's inverse
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if constexpr (Lanes > 1)
+            tk3_lfsr_bitsliced_avx512(tk_cell[1][i]);
+        if constexpr (Lanes > 2)
+            tk2_lfsr_bitsliced_avx512(tk_cell[Lanes - 1][i]);
+    }
+    for (int l = 0; l < Lanes; l++)
+        permute_cells(tk_cell[l], Qinv);
+}
+
+template <int Lanes>
+__attribute__((target("avx512f,avx512bw"))) inline void add_tweakey_lanes_avx512(__m512i *cell[16], __m512i *tk_cell[Lanes][16])
+{
+    for (int l = 0; l < Lanes; l++)
+        add_tk1_avx512(cell, tk_cell[l]);
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void add_constants_avx512(__m512i *cell[16], int r)
+{
+    const __m512i ones = _mm512_set1_epi32(-1);
+    for (uint8_t b = 0; b < 4; b++)
+        cell[0][b] = _mm512_xor_si512(cell[0][b], _mm512_set1_epi32(-static_cast<int>((RC[r] >> b) & 0x1)));
+    for (uint8_t b = 0; b < 2; b++)
+        cell[4][b] = _mm512_xor_si512(cell[4][b], _mm512_set1_epi32(-static_cast<int>((RC[r] >> (4 + b)) & 0x1)));
+    cell[8][1] = _mm512_xor_si512(cell[8][1], ones);
+}
+
+template <int Lanes>
+__attribute__((target("avx512f,avx512bw"))) inline void enc_bitsliced_multikey_avx512(int R, const uint8_t plaintext[512][16], uint8_t ciphertext[512][16], const uint8_t tweakey[512][Lanes][16])
+{
+    __m512i state[16][8], tk_state[Lanes][16][8];
+    __m512i *cell[16], *temp[16], *tmp, *tk_cell[Lanes][16];
+    pack_bitsliced_avx512(plaintext, state);
+    pack_tweakey_avx512<Lanes>(tweakey, tk_state);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        cell[i] = state[i];
+        for (int l = 0; l < Lanes; l++)
+            tk_cell[l][i] = tk_state[l][i];
+    }
+    for (int r = 0; r < R; r++)
+    {
+        if (r > 0)
+            next_tweakey_avx512<Lanes>(tk_cell);
+        // SBox
+        for (uint8_t i = 0; i < 16; i++)
+            sbox_bitsliced_avx512(cell[i]);
+        // Add constants and round tweakey
+        add_constants_avx512(cell, r);
+        add_tweakey_lanes_avx512<Lanes>(cell, tk_cell);
+        // Permute cells
+        for (uint8_t i = 0; i < 16; i++)
+            temp[i] = cell[i];
+        for (uint8_t i = 0; i < 16; i++)
+            cell[i] = temp[P[i]];
+        // MixColumn
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                cell[j + 4 * 1][b] = _mm512_xor_si512(cell[j + 4 * 1][b], cell[j + 4 * 2][b]);
+                cell[j + 4 * 2][b] = _mm512_xor_si512(cell[j + 4 * 2][b], cell[j + 4 * 0][b]);
+                cell[j + 4 * 3][b] = _mm512_xor_si512(cell[j + 4 * 3][b], cell[j + 4 * 2][b]);
+            }
+            tmp = cell[j + 4 * 3];
+            cell[j + 4 * 3] = cell[j + 4 * 2];
+            cell[j + 4 * 2] = cell[j + 4 * 1];
+            cell[j + 4 * 1] = cell[j + 4 * 0];
+            cell[j + 4 * 0] = tmp;
+        }
+    }
+    unpack_bitsliced_avx512(cell, ciphertext);
+}
+
+template <int Lanes>
+__attribute__((target("avx512f,avx512bw"))) inline void dec_bitsliced_multikey_avx512(int R, uint8_t plaintext[512][16], const uint8_t ciphertext[512][16], const uint8_t tweakey[512][Lanes][16])
+{
+    __m512i state[16][8], tk_state[Lanes][16][8];
+    __m512i *cell[16], *temp[16], *tmp, *tk_cell[Lanes][16];
+    pack_bitsliced_avx512(ciphertext, state);
+    pack_tweakey_avx512<Lanes>(tweakey, tk_state);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        cell[i] = state[i];
+        for (int l = 0; l < Lanes; l++)
+            tk_cell[l][i] = tk_state[l][i];
+    }
+    // Tweakey of the last round, then stepped back round by round
+    for (int r = 0; r < R - 1; r++)
+        next_tweakey_avx512<Lanes>(tk_cell);
+    for (int r = R - 1; r >= 0; r--)
+    {
+        if (r < R - 1)
+            prev_tweakey_avx512<Lanes>(tk_cell);
+        // MixColumn inverse
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            tmp = cell[j + 4 * 3];
+            cell[j + 4 * 3] = cell[j + 4 * 0];
+            cell[j + 4 * 0] = cell[j + 4 * 1];
+            cell[j + 4 * 1] = cell[j + 4 * 2];
+            cell[j + 4 * 2] = tmp;
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                cell[j + 4 * 3][b] = _mm512_xor_si512(cell[j + 4 * 3][b], cell[j + 4 * 2][b]);
+                cell[j + 4 * 2][b] = _mm512_xor_si512(cell[j + 4 * 2][b], cell[j + 4 * 0][b]);
+                cell[j + 4 * 1][b] = _mm512_xor_si512(cell[j + 4 * 1][b], cell[j + 4 * 2][b]);
+            }
+        }
+        // Permute cells inverse
+        for (uint8_t i = 0; i < 16; i++)
+            temp[i] = cell[i];
+        for (uint8_t i = 0; i < 16; i++)
+            cell[i] = temp[Pinv[i]];
+        // Add round tweakey and constants
+        add_tweakey_lanes_avx512<Lanes>(cell, tk_cell);
+        add_constants_avx512(cell, r);
+        // SBox inverse
+        for (uint8_t i = 0; i < 16; i++)
+            inv_sbox_bitsliced_avx512(cell[i]);
+    }
+    unpack_bitsliced_avx512(cell, plaintext);
+}
+#endif
+
+} // namespace kernels128
+} // namespace skinny
+
+#endif
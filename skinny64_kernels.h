@@ -0,0 +1,684 @@
+/*
+ * Multi-block and single-block kernels for Skinny-64 (Skinny-64-64/128/192)
+ * Date: Oct 17, 2026
+*/
+// Every kernel takes the round tweakeys produced by Skinny<64, T>::tweakey_schedule(),
+// so the same kernels serve all three tweakey sizes.
+
+#ifndef SKINNY64_KERNELS_H
+#define SKINNY64_KERNELS_H
+
+#include "skinny.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace skinny
+{
+namespace kernels64
+{
+
+// Bitsliced: 64 blocks, one uint64_t per state bit
+inline void transpose_64x64(uint64_t a[64])
+{
+    // In-place transpose of a 64x64 bit matrix (bit i of a[k] <-> bit k of a[i])
+    uint64_t m = 0x00000000FFFFFFFFULL;
+    uint64_t t;
+    for (int j = 32; j != 0; j >>= 1, m ^= (m << j))
+    {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j)
+        {
+            t = ((a[k] >> j) ^ a[k | j]) & m;
+            a[k | j] ^= t;
+            a[k] ^= (t << j);
+        }
+    }
+}
+
+inline void pack_bitsliced(const uint8_t blocks[64][16], uint64_t state[16][4])
+{
+    // Bit b of cell i of block j goes to bit j of state[i][b]
+    uint64_t *a = state[0];
+    for (int j = 0; j < 64; j++)
+    {
+        a[j] = 0;
+        for (int i = 0; i < 16; i++)
+            a[j] |= (uint64_t)(blocks[j][i] & 0xf) << (4 * i);
+    }
+    transpose_64x64(a);
+}
+
+inline void unpack_bitsliced(const uint64_t state[16][4], uint8_t blocks[64][16])
+{
+    uint64_t a[64];
+    for (int i = 0; i < 16; i++)
+        for (int b = 0; b < 4; b++)
+            a[4 * i + b] = state[i][b];
+    transpose_64x64(a);
+    for (int j = 0; j < 64; j++)
+        for (int i = 0; i < 16; i++)
+            blocks[j][i] = static_cast<uint8_t>((a[j] >> (4 * i)) & 0xf);
+}
+
+inline void sbox_bitsliced(uint64_t x[4])
+{
+    // x[0] is the least significant bit of the nibble
+    uint64_t t;
+    x[0] ^= ~(x[3] | x[2]);
+    x[3] ^= ~(x[2] | x[1]);
+    x[2] ^= ~(x[1] | x[0]);
+    x[1] ^= ~(x[3] | x[0]);
+    // Rotate the nibble by one bit to the right
+    t = x[0];
+    x[0] = x[1];
+    x[1] = x[2];
+    x[2] = x[3];
+    x[3] = t;
+}
+
+inline void inv_sbox_bitsliced(uint64_t x[4])
+{
+    uint64_t t;
+    t = x[3];
+    x[3] = x[2];
+    x[2] = x[1];
+    x[1] = x[0];
+    x[0] = t;
+    x[1] ^= ~(x[3] | x[0]);
+    x[2] ^= ~(x[1] | x[0]);
+    x[3] ^= ~(x[2] | x[1]);
+    x[0] ^= ~(x[3] | x[2]);
+}
+
+inline void shift_rows_bitsliced(uint64_t state[16][4])
+{
+    uint64_t tmp;
+    for (uint8_t b = 0; b < 4; b++)
+    {
+        // Second row: rotate one cell to the right
+        tmp = state[7][b];
+        state[7][b] = state[6][b];
+        state[6][b] = state[5][b];
+        state[5][b] = state[4][b];
+        state[4][b] = tmp;
+        // Third row: rotate two cells
+        tmp = state[8][b];
+        state[8][b] = state[10][b];
+        state[10][b] = tmp;
+        tmp = state[9][b];
+        state[9][b] = state[11][b];
+        state[11][b] = tmp;
+        // Fourth row: rotate three cells to the right
+        tmp = state[12][b];
+        state[12][b] = state[13][b];
+        state[13][b] = state[14][b];
+        state[14][b] = state[15][b];
+        state[15][b] = tmp;
+    }
+}
+
+inline void inv_shift_rows_bitsliced(uint64_t state[16][4])
+{
+    uint64_t tmp;
+    for (uint8_t b = 0; b < 4; b++)
+    {
+        tmp = state[4][b];
+        state[4][b] = state[5][b];
+        state[5][b] = state[6][b];
+        state[6][b] = state[7][b];
+        state[7][b] = tmp;
+        tmp = state[8][b];
+        state[8][b] = state[10][b];
+        state[10][b] = tmp;
+        tmp = state[9][b];
+        state[9][b] = state[11][b];
+        state[11][b] = tmp;
+        tmp = state[15][b];
+        state[15][b] = state[14][b];
+        state[14][b] = state[13][b];
+        state[13][b] = state[12][b];
+        state[12][b] = tmp;
+    }
+}
+
+inline void mix_columns_bitsliced(uint64_t state[16][4])
+{
+    uint64_t tmp;
+    for (uint8_t j = 0; j < 4; j++)
+        for (uint8_t b = 0; b < 4; b++)
+        {
+            state[j + 4 * 1][b] ^= state[j + 4 * 2][b];
+            state[j + 4 * 2][b] ^= state[j + 4 * 0][b];
+            state[j + 4 * 3][b] ^= state[j + 4 * 2][b];
+            tmp = state[j + 4 * 3][b];
+            state[j + 4 * 3][b] = state[j + 4 * 2][b];
+            state[j + 4 * 2][b] = state[j + 4 * 1][b];
+            state[j + 4 * 1][b] = state[j + 4 * 0][b];
+            state[j + 4 * 0][b] = tmp;
+        }
+}
+
+inline void inv_mix_columns_bitsliced(uint64_t state[16][4])
+{
+    uint64_t tmp;
+    for (uint8_t j = 0; j < 4; j++)
+        for (uint8_t b = 0; b < 4; b++)
+        {
+            tmp = state[j + 4 * 3][b];
+            state[j + 4 * 3][b] = state[j + 4 * 0][b];
+            state[j + 4 * 0][b] = state[j + 4 * 1][b];
+            state[j + 4 * 1][b] = state[j + 4 * 2][b];
+            state[j + 4 * 2][b] = tmp;
+            state[j + 4 * 3][b] ^= state[j + 4 * 2][b];
+            state[j + 4 * 2][b] ^= state[j + 4 * 0][b];
+            state[j + 4 * 1][b] ^= state[j + 4 * 2][b];
+        }
+}
+
+// The 64 states in cells for a trace policy (see NoTrace)
+template <class Trace>
+inline void trace_bitsliced(const Trace &trace, int round, TraceStep step, const uint64_t state[16][4])
+{
+    if constexpr (Trace::ENABLED)
+    {
+        uint8_t blocks[64][16];
+        unpack_bitsliced(state, blocks);
+        trace(round, step, 0, 64, blocks);
+    }
+}
+
+template <class Trace = NoTrace>
+inline void enc_bitsliced(int R, const uint8_t plaintext[64][16], uint8_t ciphertext[64][16], const uint8_t tk[][8], const Trace &trace = Trace())
+{
+    // Encrypts 64 blocks at once, one uint64_t per state bit (bit j belongs to block j)
+    uint64_t state[16][4];
+    pack_bitsliced(plaintext, state);
+    for (int r = 0; r < R; r++)
+    {
+        // SBox
+        for (uint8_t i = 0; i < 16; i++)
+            sbox_bitsliced(state[i]);
+        trace_bitsliced(trace, r, TRACE_SUB_CELLS, state);
+        // Add constants (a set constant bit complements the whole bit-plane)
+        for (uint8_t b = 0; b < 4; b++)
+            state[0][b] ^= -(uint64_t)((RC[r] >> b) & 0x1);
+        for (uint8_t b = 0; b < 2; b++)
+            state[4][b] ^= -(uint64_t)((RC[r] >> (4 + b)) & 0x1);
+        state[8][1] = ~state[8][1];
+        trace_bitsliced(trace, r, TRACE_ADD_CONSTANTS, state);
+        // Add round tweakey (the same tweakey is broadcast to all 64 blocks)
+        for (uint8_t i = 0; i < 8; i++)
+            for (uint8_t b = 0; b < 4; b++)
+                state[i][b] ^= -(uint64_t)((tk[r][i] >> b) & 0x1);
+        trace_bitsliced(trace, r, TRACE_ADD_ROUND_TWEAKEY, state);
+        // Permute nibbles
+        shift_rows_bitsliced(state);
+        trace_bitsliced(trace, r, TRACE_SHIFT_ROWS, state);
+        // MixColumn
+        mix_columns_bitsliced(state);
+        trace_bitsliced(trace, r, TRACE_MIX_COLUMNS, state);
+    }
+    unpack_bitsliced(state, ciphertext);
+}
+
+template <class Trace = NoTrace>
+inline void dec_bitsliced(int R, uint8_t plaintext[64][16], const uint8_t ciphertext[64][16], const uint8_t tk[][8], const Trace &trace = Trace())
+{
+    uint64_t state[16][4];
+    int ind;
+    pack_bitsliced(ciphertext, state);
+    for (int r = 0; r < R; r++)
+    {
+        // MixColumn inverse
+        ind = R - r - 1;
+        inv_mix_columns_bitsliced(state);
+        trace_bitsliced(trace, ind, TRACE_MIX_COLUMNS, state);
+        // Permute nibble inverse
+        inv_shift_rows_bitsliced(state);
+        trace_bitsliced(trace, ind, TRACE_SHIFT_ROWS, state);
+        // Add tweakey
+        for (uint8_t i = 0; i < 8; i++)
+            for (uint8_t b = 0; b < 4; b++)
+                state[i][b] ^= -(uint64_t)((tk[ind][i] >> b) & 0x1);
+        trace_bitsliced(trace, ind, TRACE_ADD_ROUND_TWEAKEY, state);
+        // Add constants
+        for (uint8_t b = 0; b < 4; b++)
+            state[0][b] ^= -(uint64_t)((RC[ind] >> b) & 0x1);
+        for (uint8_t b = 0; b < 2; b++)
+            state[4][b] ^= -(uint64_t)((RC[ind] >> (4 + b)) & 0x1);
+        state[8][1] = ~state[8][1];
+        trace_bitsliced(trace, ind, TRACE_ADD_CONSTANTS, state);
+        // SBox inverse
+        for (uint8_t i = 0; i < 16; i++)
+            inv_sbox_bitsliced(state[i]);
+        trace_bitsliced(trace, ind, TRACE_SUB_CELLS, state);
+    }
+    unpack_bitsliced(state, plaintext);
+}
+
+// Multi-key bitsliced: every one of the 64 blocks has its own Lanes-lane tweakey. The
+// tweakey lanes are bitsliced like the state and the schedule runs on the bit-planes:
+// Q moves cells, the TK2/TK3 LFSRs shift the four planes of a cell with one XOR.
+inline void tk2_lfsr_bitsliced(uint64_t x[4])
+{
+    uint64_t feedback = x[3] ^ x[2];
+    x[3] = x[2];
+    x[2] = x[1];
+    x[1] = x[0];
+    x[0] = feedback;
+}
+
+inline void tk3_lfsr_bitsliced(uint64_t x[4])
+{
+    uint64_t feedback = x[0] ^ x[3];
+    x[0] = x[1];
+    x[1] = x[2];
+    x[2] = x[3];
+    x[3] = feedback;
+}
+
+inline void permute_tweakey_bitsliced(uint64_t t[16][4], const uint8_t perm[16])
+{
+    uint64_t temp[16][4];
+    memcpy(temp, t, sizeof(temp));
+    for (uint8_t i = 0; i < 16; i++)
+        memcpy(t[i], temp[perm[i]], sizeof(t[i]));
+}
+
+template <int Lanes>
+inline void pack_tweakey_bitsliced(const uint8_t tweakey[64][Lanes][16], uint64_t t[Lanes][16][4])
+{
+    uint8_t lane[64][16];
+    for (int l = 0; l < Lanes; l++)
+    {
+        for (uint8_t j = 0; j < 64; j++)
+            memcpy(lane[j], tweakey[j][l], 16);
+        pack_bitsliced(lane, t[l]);
+    }
+}
+
+template <int Lanes>
+inline void next_tweakey_bitsliced(uint64_t t[Lanes][16][4])
+{
+    for (int l = 0; l < Lanes; l++)
+        permute_tweakey_bitsliced(t[l], Q);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if constexpr (Lanes > 1)
+            tk2_lfsr_bitsliced(t[1][i]);
+        if constexpr (Lanes > 2)
+            tk3_lfsr_bitsliced(t[Lanes - 1][i]);
+    }
+}
+
+template <int Lanes>
+inline void prev_tweakey_bitsliced(uint64_t t[Lanes][16][4])
+{
+    // The TK2 and TK3 LFSRs are each other's inverse
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if constexpr (Lanes > 1)
+            tk3_lfsr_bitsliced(t[1][i]);
+        if constexpr (Lanes > 2)
+            tk2_lfsr_bitsliced(t[Lanes - 1][i]);
+    }
+    for (int l = 0; l < Lanes; l++)
+        permute_tweakey_bitsliced(t[l], Qinv);
+}
+
+template <int Lanes>
+inline void add_tweakey_bitsliced(uint64_t state[16][4], const uint64_t t[Lanes][16][4])
+{
+    for (int l = 0; l < Lanes; l++)
+        for (uint8_t i = 0; i < 8; i++)
+            for (uint8_t b = 0; b < 4; b++)
+                state[i][b] ^= t[l][i][b];
+}
+
+inline void add_constants_bitsliced(uint64_t state[16][4], int r)
+{
+    for (uint8_t b = 0; b < 4; b++)
+        state[0][b] ^= -(uint64_t)((RC[r] >> b) & 0x1);
+    for (uint8_t b = 0; b < 2; b++)
+        state[4][b] ^= -(uint64_t)((RC[r] >> (4 + b)) & 0x1);
+    state[8][1] = ~state[8][1];
+}
+
+// tweakey[j] holds the lanes TK1, TK2, TK3 of block j
+template <int Lanes>
+inline void enc_bitsliced_multikey(int R, const uint8_t plaintext[64][16], uint8_t ciphertext[64][16], const uint8_t tweakey[64][Lanes][16])
+{
+    uint64_t state[16][4], t[Lanes][16][4];
+    pack_bitsliced(plaintext, state);
+    pack_tweakey_bitsliced<Lanes>(tweakey, t);
+    for (int r = 0; r < R; r++)
+    {
+        if (r > 0)
+            next_tweakey_bitsliced<Lanes>(t);
+        for (uint8_t i = 0; i < 16; i++)
+            sbox_bitsliced(state[i]);
+        add_constants_bitsliced(state, r);
+        add_tweakey_bitsliced<Lanes>(state, t);
+        shift_rows_bitsliced(state);
+        mix_columns_bitsliced(state);
+    }
+    unpack_bitsliced(state, ciphertext);
+}
+
+template <int Lanes>
+inline void dec_bitsliced_multikey(int R, uint8_t plaintext[64][16], const uint8_t ciphertext[64][16], const uint8_t tweakey[64][Lanes][16])
+{
+    uint64_t state[16][4], t[Lanes][16][4];
+    pack_bitsliced(ciphertext, state);
+    pack_tweakey_bitsliced<Lanes>(tweakey, t);
+    // Tweakey of the last round, then stepped back round by round
+    for (int r = 0; r < R - 1; r++)
+        next_tweakey_bitsliced<Lanes>(t);
+    for (int r = R - 1; r >= 0; r--)
+    {
+        if (r < R - 1)
+            prev_tweakey_bitsliced<Lanes>(t);
+        inv_mix_columns_bitsliced(state);
+        inv_shift_rows_bitsliced(state);
+        add_tweakey_bitsliced<Lanes>(state, t);
+        add_constants_bitsliced(state, r);
+        for (uint8_t i = 0; i < 16; i++)
+            inv_sbox_bitsliced(state[i]);
+    }
+    unpack_bitsliced(state, plaintext);
+}
+
+// Packed: one block in a uint64_t
+inline uint64_t pack_state(const uint8_t state[16])
+{
+    // Cell 0 is the most significant nibble, so row i occupies bits 48 - 16i to 63 - 16i
+    uint64_t x = 0;
+    for (uint8_t i = 0; i < 16; i++)
+        x = (x << 4) | (state[i] & 0xf);
+    return x;
+}
+
+inline void unpack_state(uint64_t x, uint8_t state[16])
+{
+    for (uint8_t i = 0; i < 16; i++)
+        state[i] = static_cast<uint8_t>((x >> (60 - 4 * i)) & 0xf);
+}
+
+inline void tweakey_schedule_packed(int rounds, const uint8_t round_tweakey[][8], uint64_t rtk[])
+{
+    // Round tweakey and round constants of every round as one packed state word
+    uint8_t cells[16];
+    for (int r = 0; r < rounds; r++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            cells[i] = (i < 8) ? round_tweakey[r][i] : 0;
+        cells[0] ^= (RC[r] & 0xf);
+        cells[4] ^= ((RC[r] >> 4) & 0x3);
+        cells[8] ^= 0x2;
+        rtk[r] = pack_state(cells);
+    }
+}
+
+inline uint64_t enc_packed(int R, uint64_t plaintext, const uint64_t rtk[])
+{
+    uint64_t x = plaintext;
+    uint64_t y;
+    for (int r = 0; r < R; r++)
+    {
+        // SBox (two nibbles per lookup)
+        y = 0;
+        for (uint8_t i = 0; i < 64; i += 8)
+            y |= (uint64_t)S2[(x >> i) & 0xff] << i;
+        // Add constants and round tweakey
+        x = y ^ rtk[r];
+        // Permute nibbles (rotate row i by i nibbles to the right)
+        x = (x & 0xFFFF000000000000ULL) |
+            ((x >> 4) & 0x00000FFF00000000ULL) | ((x << 12) & 0x0000F00000000000ULL) |
+            ((x >> 8) & 0x0000000000FF0000ULL) | ((x << 8) & 0x00000000FF000000ULL) |
+            ((x >> 12) & 0x000000000000000FULL) | ((x << 4) & 0x000000000000FFF0ULL);
+        // MixColumn
+        x ^= (x << 16) & 0x0000FFFF00000000ULL;
+        x ^= (x >> 32) & 0x00000000FFFF0000ULL;
+        x ^= (x >> 16) & 0x000000000000FFFFULL;
+        x = (x >> 16) | (x << 48);
+    }
+    return x;
+}
+
+inline uint64_t dec_packed(int R, uint64_t ciphertext, const uint64_t rtk[])
+{
+    uint64_t x = ciphertext;
+    uint64_t y;
+    for (int r = R - 1; r >= 0; r--)
+    {
+        // MixColumn inverse
+        x = (x << 16) | (x >> 48);
+        x ^= (x >> 16) & 0x000000000000FFFFULL;
+        x ^= (x >> 32) & 0x00000000FFFF0000ULL;
+        x ^= (x << 16) & 0x0000FFFF00000000ULL;
+        // Permute nibbles inverse (rotate row i by i nibbles to the left)
+        x = (x & 0xFFFF000000000000ULL) |
+            ((x << 4) & 0x0000FFF000000000ULL) | ((x >> 12) & 0x0000000F00000000ULL) |
+            ((x << 8) & 0x00000000FF000000ULL) | ((x >> 8) & 0x0000000000FF0000ULL) |
+            ((x << 12) & 0x000000000000F000ULL) | ((x >> 4) & 0x0000000000000FFFULL);
+        // Add round tweakey and constants
+        x ^= rtk[r];
+        // SBox inverse
+        y = 0;
+        for (uint8_t i = 0; i < 64; i += 8)
+            y |= (uint64_t)S2inv[(x >> i) & 0xff] << i;
+        x = y;
+    }
+    return x;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Byte-sliced: one block per 128-bit lane, 16 (SSSE3), 32 (AVX2) or 64 (AVX-512) blocks
+inline void shuffle_masks(uint8_t mc[3][16], uint8_t inv_mc[3][16])
+{
+    // A round ends with out = shuffle(x, mc[0]) ^ shuffle(x, mc[1]) ^ shuffle(x, mc[2]),
+    // which is the nibble permutation P followed by MixColumn. Each entry names the source
+    // row of one term per output row, 0xff leaves the term out (pshufb writes zero).
+    const uint8_t mc_rows[3][4] = {{0, 0, 1, 0}, {2, 0xff, 2, 2}, {3, 0xff, 0xff, 0xff}};
+    const uint8_t inv_mc_rows[3][4] = {{1, 1, 1, 0}, {0xff, 2, 3, 3}, {0xff, 3, 0xff, 0xff}};
+    for (uint8_t n = 0; n < 3; n++)
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            uint8_t row = mc_rows[n][i >> 2];
+            mc[n][i] = (row == 0xff) ? 0x80 : P[4 * row + (i & 0x3)];
+            row = inv_mc_rows[n][i >> 2];
+            inv_mc[n][i] = (row == 0xff) ? 0x80 : 4 * row + (Pinv[i] & 0x3);
+        }
+}
+
+inline void round_key_vector(int r, const uint8_t tk[][8], uint8_t rk[16])
+{
+    // Round tweakey and round constants of round r as one 16-cell vector
+    for (uint8_t i = 0; i < 16; i++)
+        rk[i] = (i < 8) ? tk[r][i] : 0;
+    rk[0] ^= (RC[r] & 0xf);
+    rk[4] ^= ((RC[r] >> 4) & 0x3);
+    rk[8] ^= 0x2;
+}
+
+__attribute__((target("ssse3"))) inline void enc_ssse3(int R, const uint8_t plaintext[16][16], uint8_t ciphertext[16][16], const uint8_t tk[][8])
+{
+    // Encrypts 16 blocks, one block (one nibble per byte) in each xmm register
+    uint8_t mc[3][16], inv_mc[3][16], rk[16];
+    shuffle_masks(mc, inv_mc);
+    const __m128i sbox = _mm_loadu_si128((const __m128i *)S4);
+    const __m128i m0 = _mm_loadu_si128((const __m128i *)mc[0]);
+    const __m128i m1 = _mm_loadu_si128((const __m128i *)mc[1]);
+    const __m128i m2 = _mm_loadu_si128((const __m128i *)mc[2]);
+    const __m128i low = _mm_set1_epi8(0xf);
+    __m128i x[16], k;
+    for (uint8_t j = 0; j < 16; j++)
+        x[j] = _mm_and_si128(_mm_loadu_si128((const __m128i *)plaintext[j]), low);
+    for (int r = 0; r < R; r++)
+    {
+        round_key_vector(r, tk, rk);
+        k = _mm_loadu_si128((const __m128i *)rk);
+        for (uint8_t j = 0; j < 16; j++)
+        {
+            // SBox, then constants and round tweakey
+            x[j] = _mm_xor_si128(_mm_shuffle_epi8(sbox, x[j]), k);
+            // Permute nibbles and MixColumn
+            x[j] = _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi8(x[j], m0), _mm_shuffle_epi8(x[j], m1)),
+                                 _mm_shuffle_epi8(x[j], m2));
+        }
+    }
+    for (uint8_t j = 0; j < 16; j++)
+        _mm_storeu_si128((__m128i *)ciphertext[j], x[j]);
+}
+
+__attribute__((target("ssse3"))) inline void dec_ssse3(int R, uint8_t plaintext[16][16], const uint8_t ciphertext[16][16], const uint8_t tk[][8])
+{
+    uint8_t mc[3][16], inv_mc[3][16], rk[16];
+    shuffle_masks(mc, inv_mc);
+    const __m128i sbox_inv = _mm_loadu_si128((const __m128i *)S4inv);
+    const __m128i m0 = _mm_loadu_si128((const __m128i *)inv_mc[0]);
+    const __m128i m1 = _mm_loadu_si128((const __m128i *)inv_mc[1]);
+    const __m128i m2 = _mm_loadu_si128((const __m128i *)inv_mc[2]);
+    const __m128i low = _mm_set1_epi8(0xf);
+    __m128i x[16], k;
+    for (uint8_t j = 0; j < 16; j++)
+        x[j] = _mm_and_si128(_mm_loadu_si128((const __m128i *)ciphertext[j]), low);
+    for (int r = R - 1; r >= 0; r--)
+    {
+        round_key_vector(r, tk, rk);
+        k = _mm_loadu_si128((const __m128i *)rk);
+        for (uint8_t j = 0; j < 16; j++)
+        {
+            // MixColumn inverse and nibble permutation inverse
+            x[j] = _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi8(x[j], m0), _mm_shuffle_epi8(x[j], m1)),
+                                 _mm_shuffle_epi8(x[j], m2));
+            // Round tweakey and constants, then SBox inverse
+            x[j] = _mm_shuffle_epi8(sbox_inv, _mm_xor_si128(x[j], k));
+        }
+    }
+    for (uint8_t j = 0; j < 16; j++)
+        _mm_storeu_si128((__m128i *)plaintext[j], x[j]);
+}
+
+__attribute__((target("avx2"))) inline void enc_avx2(int R, const uint8_t plaintext[32][16], uint8_t ciphertext[32][16], const uint8_t tk[][8])
+{
+    // Encrypts 32 blocks, two blocks in each ymm register (vpshufb works per 128-bit lane)
+    uint8_t mc[3][16], inv_mc[3][16], rk[16];
+    shuffle_masks(mc, inv_mc);
+    const __m256i sbox = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)S4));
+    const __m256i m0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)mc[0]));
+    const __m256i m1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)mc[1]));
+    const __m256i m2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)mc[2]));
+    const __m256i low = _mm256_set1_epi8(0xf);
+    __m256i x[16], k;
+    for (uint8_t j = 0; j < 16; j++)
+        x[j] = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)plaintext[2 * j]), low);
+    for (int r = 0; r < R; r++)
+    {
+        round_key_vector(r, tk, rk);
+        k = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)rk));
+        for (uint8_t j = 0; j < 16; j++)
+        {
+            x[j] = _mm256_xor_si256(_mm256_shuffle_epi8(sbox, x[j]), k);
+            x[j] = _mm256_xor_si256(_mm256_xor_si256(_mm256_shuffle_epi8(x[j], m0), _mm256_shuffle_epi8(x[j], m1)),
+                                    _mm256_shuffle_epi8(x[j], m2));
+        }
+    }
+    for (uint8_t j = 0; j < 16; j++)
+        _mm256_storeu_si256((__m256i *)ciphertext[2 * j], x[j]);
+}
+
+__attribute__((target("avx2"))) inline void dec_avx2(int R, uint8_t plaintext[32][16], const uint8_t ciphertext[32][16], const uint8_t tk[][8])
+{
+    uint8_t mc[3][16], inv_mc[3][16], rk[16];
+    shuffle_masks(mc, inv_mc);
+    const __m256i sbox_inv = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)S4inv));
+    const __m256i m0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)inv_mc[0]));
+    const __m256i m1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)inv_mc[1]));
+    const __m256i m2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)inv_mc[2]));
+    const __m256i low = _mm256_set1_epi8(0xf);
+    __m256i x[16], k;
+    for (uint8_t j = 0; j < 16; j++)
+        x[j] = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)ciphertext[2 * j]), low);
+    for (int r = R - 1; r >= 0; r--)
+    {
+        round_key_vector(r, tk, rk);
+        k = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)rk));
+        for (uint8_t j = 0; j < 16; j++)
+        {
+            x[j] = _mm256_xor_si256(_mm256_xor_si256(_mm256_shuffle_epi8(x[j], m0), _mm256_shuffle_epi8(x[j], m1)),
+                                    _mm256_shuffle_epi8(x[j], m2));
+            x[j] = _mm256_shuffle_epi8(sbox_inv, _mm256_xor_si256(x[j], k));
+        }
+    }
+    for (uint8_t j = 0; j < 16; j++)
+        _mm256_storeu_si256((__m256i *)plaintext[2 * j], x[j]);
+}
+
+__attribute__((target("avx512f"))) inline __m512i broadcast_x4(const uint8_t v[16])
+{
+    // Masked form of _mm512_broadcast_i32x4(), whose unmasked form trips -Wuninitialized in GCC 12 headers
+    return _mm512_maskz_broadcast_i32x4(0xffff, _mm_loadu_si128((const __m128i *)v));
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void enc_avx512(int R, const uint8_t plaintext[64][16], uint8_t ciphertext[64][16], const uint8_t tk[][8])
+{
+    // Encrypts 64 blocks, four blocks in each zmm register (vpshufb works per 128-bit lane)
+    uint8_t mc[3][16], inv_mc[3][16], rk[16];
+    shuffle_masks(mc, inv_mc);
+    const __m512i sbox = broadcast_x4(S4);
+    const __m512i m0 = broadcast_x4(mc[0]);
+    const __m512i m1 = broadcast_x4(mc[1]);
+    const __m512i m2 = broadcast_x4(mc[2]);
+    const __m512i low = _mm512_set1_epi8(0xf);
+    __m512i x[16], k;
+    for (uint8_t j = 0; j < 16; j++)
+        x[j] = _mm512_and_si512(_mm512_loadu_si512((const void *)plaintext[4 * j]), low);
+    for (int r = 0; r < R; r++)
+    {
+        round_key_vector(r, tk, rk);
+        k = broadcast_x4(rk);
+        for (uint8_t j = 0; j < 16; j++)
+        {
+            x[j] = _mm512_xor_si512(_mm512_shuffle_epi8(sbox, x[j]), k);
+            // Three-way XOR in one vpternlog
+            x[j] = _mm512_ternarylogic_epi64(_mm512_shuffle_epi8(x[j], m0), _mm512_shuffle_epi8(x[j], m1),
+                                             _mm512_shuffle_epi8(x[j], m2), 0x96);
+        }
+    }
+    for (uint8_t j = 0; j < 16; j++)
+        _mm512_storeu_si512((void *)ciphertext[4 * j], x[j]);
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void dec_avx512(int R, uint8_t plaintext[64][16], const uint8_t ciphertext[64][16], const uint8_t tk[][8])
+{
+    uint8_t mc[3][16], inv_mc[3][16], rk[16];
+    shuffle_masks(mc, inv_mc);
+    const __m512i sbox_inv = broadcast_x4(S4inv);
+    const __m512i m0 = broadcast_x4(inv_mc[0]);
+    const __m512i m1 = broadcast_x4(inv_mc[1]);
+    const __m512i m2 = broadcast_x4(inv_mc[2]);
+    const __m512i low = _mm512_set1_epi8(0xf);
+    __m512i x[16], k;
+    for (uint8_t j = 0; j < 16; j++)
+        x[j] = _mm512_and_si512(_mm512_loadu_si512((const void *)ciphertext[4 * j]), low);
+    for (int r = R - 1; r >= 0; r--)
+    {
+        round_key_vector(r, tk, rk);
+        k = broadcast_x4(rk);
+        for (uint8_t j = 0; j < 16; j++)
+        {
+            x[j] = _mm512_ternarylogic_epi64(_mm512_shuffle_epi8(x[j], m0), _mm512_shuffle_epi8(x[j], m1),
+                                             _mm512_shuffle_epi8(x[j], m2), 0x96);
+            x[j] = _mm512_shuffle_epi8(sbox_inv, _mm512_xor_si512(x[j], k));
+        }
+    }
+    for (uint8_t j = 0; j < 16; j++)
+        _mm512_storeu_si512((void *)plaintext[4 * j], x[j]);
+}
+#endif
+
+} // namespace kernels64
+} // namespace skinny
+
+#endif
@@ -0,0 +1,261 @@
+/*
+ * SKINNY-AEAD M1/M2: the parallel ThetaCB3 mode on Skinny-128-384
+ * Date: Oct 17, 2026
+*/
+// Every block is encrypted under its own tweakey TK1 = LFSR(block number) || 0^56 || d,
+// TK2 = nonce (M1: 128 bits, M2: 96 bits followed by zeros), TK3 = key, associated data
+// included. The 64-bit LFSR (x^64 + x^4 + x^3 + x + 1) starts at 1 and fills TK1[0..7],
+// least significant byte first. The domain byte d is the member (M1 0x00, M2 0x10) ORed
+// with the block type:
+//   0 message block, 1 pad of a partial last message block, 2 associated-data block,
+//   3 partial last associated-data block, 4 / 5 tag after a full / partial last block.
+// tag = E(N, l, 4 or 5)(XOR of the message blocks) ^ XOR of the E(A_i), where l is the
+// number of message blocks, the pad of a partial last block included.
+// No block depends on another: the full blocks are cut into chunks of CHUNK_BLOCKS, each
+// chunk runs the per-block TK1 batch kernels of select_kernels() and leaves a partial
+// checksum, and the partial checksums are XORed together at the end. Given a
+// WorkStealingPool, the chunks of the message and the associated data run on all its threads.
+
+#ifndef SKINNY_AEAD_H
+#define SKINNY_AEAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include "skinny_dispatch.h"
+#include "work_pool.h"
+
+namespace skinny
+{
+
+class SkinnyAead
+{
+public:
+    typedef Skinny128_384 Cipher;
+    static constexpr int R = Cipher::ROUNDS;
+    static const int KEY_BYTES = 16;
+    static const int TAG_BYTES = 16;
+    static constexpr size_t CHUNK_BLOCKS = 2048;
+
+    enum Member
+    {
+        M1,
+        M2
+    };
+
+    SkinnyAead(const uint8_t key[16], Member member = M1) : member_(member), kernels_(select_kernels<Cipher>())
+    {
+        memcpy(key_, key, 16);
+    }
+
+    int nonce_bytes() const { return (member_ == M1) ? 16 : 12; }
+
+    // Member bits of the domain byte
+    uint8_t prefix() const { return (member_ == M1) ? 0x00 : 0x10; }
+
+    // c = ciphertext || tag; returns mlen + 16
+    size_t encrypt(const uint8_t *nonce, const uint8_t *ad, size_t adlen, const uint8_t *m, size_t mlen, uint8_t *c, WorkStealingPool &pool) const
+    {
+        return seal(nonce, ad, adlen, m, mlen, c, &pool);
+    }
+
+    size_t encrypt(const uint8_t *nonce, const uint8_t *ad, size_t adlen, const uint8_t *m, size_t mlen, uint8_t *c) const
+    {
+        return seal(nonce, ad, adlen, m, mlen, c, NULL);
+    }
+
+    // Returns false (and zeroes m) if the tag does not match
+    bool decrypt(const uint8_t *nonce, const uint8_t *ad, size_t adlen, const uint8_t *c, size_t clen, uint8_t *m, WorkStealingPool &pool) const
+    {
+        return open(nonce, ad, adlen, c, clen, m, &pool);
+    }
+
+    bool decrypt(const uint8_t *nonce, const uint8_t *ad, size_t adlen, const uint8_t *c, size_t clen, uint8_t *m) const
+    {
+        return open(nonce, ad, adlen, c, clen, m, NULL);
+    }
+
+    static uint64_t clock_lfsr(uint64_t x)
+    {
+        return (x << 1) ^ ((0 - (x >> 63)) & 0x1b);
+    }
+
+    // LFSR state of block number n: x^n, one multiplication per bit of n instead of n clocks
+    static uint64_t lfsr_at(uint64_t n)
+    {
+        uint64_t result = 1, power = 2;
+        for (; n != 0; n >>= 1)
+        {
+            if (n & 0x1)
+                result = gf_mul(result, power);
+            power = gf_mul(power, power);
+        }
+        return result;
+    }
+
+    static void compose_tk1(uint64_t lfsr, uint8_t domain, uint8_t tk1[16])
+    {
+        for (uint8_t k = 0; k < 8; k++)
+            tk1[k] = static_cast<uint8_t>(lfsr >> (8 * k));
+        memset(tk1 + 8, 0, 7);
+        tk1[15] = domain;
+    }
+
+private:
+    static uint64_t gf_mul(uint64_t a, uint64_t b)
+    {
+        uint64_t r = 0;
+        for (int i = 0; i < 64; i++, b >>= 1)
+        {
+            r ^= (0 - (b & 0x1)) & a;
+            a = clock_lfsr(a);
+        }
+        return r;
+    }
+
+    void nonce_schedule(const uint8_t *nonce, uint8_t rtk[][8]) const
+    {
+        uint8_t tk[3][16];
+        memset(tk, 0, sizeof(tk));
+        memcpy(tk[1], nonce, nonce_bytes());
+        memcpy(tk[2], key_, 16);
+        kernels_.tweakey_schedule(tk, rtk);
+    }
+
+    void tbc(uint8_t block[1][16], uint64_t n, uint8_t domain, const uint8_t rtk[][8]) const
+    {
+        uint8_t tk1[1][16];
+        compose_tk1(lfsr_at(n), prefix() | domain, tk1[0]);
+        kernels_.encrypt_tk1(block, block, tk1, 1, rtk);
+    }
+
+    // Full message blocks (encrypted or decrypted) and full associated-data blocks, by
+    // chunks; checksum = XOR of the plaintext blocks, auth = XOR of the encrypted AD blocks
+    void bulk(const uint8_t *in, uint8_t *out, size_t blocks, bool decrypt, const uint8_t *ad, size_t ad_blocks,
+              const uint8_t rtk[][8], uint8_t checksum[16], uint8_t auth[16], WorkStealingPool *pool) const
+    {
+        const size_t m_tasks = (blocks + CHUNK_BLOCKS - 1) / CHUNK_BLOCKS;
+        const size_t tasks = m_tasks + (ad_blocks + CHUNK_BLOCKS - 1) / CHUNK_BLOCKS;
+        std::unique_ptr<uint8_t[]> partial(new uint8_t[16 * tasks + 1]);
+        auto task = [&](size_t t) {
+            uint8_t tk1[CHUNK_BLOCKS][16];
+            uint8_t sum[16] = {0};
+            bool message = (t < m_tasks);
+            size_t first = (message ? t : t - m_tasks) * CHUNK_BLOCKS;
+            size_t n = std::min(CHUNK_BLOCKS, (message ? blocks : ad_blocks) - first);
+            uint64_t lfsr = lfsr_at(first);
+            for (size_t j = 0; j < n; j++, lfsr = clock_lfsr(lfsr))
+                compose_tk1(lfsr, prefix() | (message ? 0 : 2), tk1[j]);
+            if (message)
+            {
+                const uint8_t(*src)[16] = reinterpret_cast<const uint8_t(*)[16]>(in + 16 * first);
+                uint8_t(*dst)[16] = reinterpret_cast<uint8_t(*)[16]>(out + 16 * first);
+                if (decrypt)
+                    kernels_.decrypt_tk1(dst, src, tk1, n, rtk);
+                const uint8_t(*plain)[16] = decrypt ? dst : src;
+                for (size_t j = 0; j < n; j++)
+                    for (uint8_t i = 0; i < 16; i++)
+                        sum[i] ^= plain[j][i];
+                if (!decrypt)
+                    kernels_.encrypt_tk1(src, dst, tk1, n, rtk);
+            }
+            else
+            {
+                uint8_t encrypted[CHUNK_BLOCKS][16];
+                kernels_.encrypt_tk1(reinterpret_cast<const uint8_t(*)[16]>(ad + 16 * first), encrypted, tk1, n, rtk);
+                for (size_t j = 0; j < n; j++)
+                    for (uint8_t i = 0; i < 16; i++)
+                        sum[i] ^= encrypted[j][i];
+            }
+            memcpy(&partial[16 * t], sum, 16);
+        };
+        if (pool != NULL)
+            pool->run(tasks, task);
+        else
+            for (size_t t = 0; t < tasks; t++)
+                task(t);
+        memset(checksum, 0, 16);
+        memset(auth, 0, 16);
+        for (size_t t = 0; t < tasks; t++)
+            for (uint8_t i = 0; i < 16; i++)
+                (t < m_tasks ? checksum : auth)[i] ^= partial[16 * t + i];
+    }
+
+    void finish(uint8_t checksum[16], uint8_t auth[16], const uint8_t *ad, size_t adlen, size_t mlen,
+                const uint8_t rtk[][8], uint8_t tag[16]) const
+    {
+        uint8_t block[1][16];
+        if (adlen % 16 != 0)
+        {
+            memset(block[0], 0, 16);
+            memcpy(block[0], ad + adlen - adlen % 16, adlen % 16);
+            block[0][adlen % 16] = 0x80;
+            tbc(block, adlen / 16, 3, rtk);
+            for (uint8_t i = 0; i < 16; i++)
+                auth[i] ^= block[0][i];
+        }
+        memcpy(block[0], checksum, 16);
+        tbc(block, (mlen + 15) / 16, (mlen % 16 != 0) ? 5 : 4, rtk);
+        for (uint8_t i = 0; i < 16; i++)
+            tag[i] = block[0][i] ^ auth[i];
+    }
+
+    size_t seal(const uint8_t *nonce, const uint8_t *ad, size_t adlen, const uint8_t *m, size_t mlen, uint8_t *c, WorkStealingPool *pool) const
+    {
+        uint8_t rtk[R][8], checksum[16], auth[16], pad[1][16];
+        size_t full = mlen / 16, rest = mlen % 16;
+        nonce_schedule(nonce, rtk);
+        bulk(m, c, full, false, ad, adlen / 16, rtk, checksum, auth, pool);
+        if (rest > 0)
+        {
+            memset(pad[0], 0, 16);
+            tbc(pad, full, 1, rtk);
+            for (size_t i = 0; i < rest; i++)
+            {
+                checksum[i] ^= m[16 * full + i];
+                c[16 * full + i] = m[16 * full + i] ^ pad[0][i];
+            }
+            checksum[rest] ^= 0x80;
+        }
+        finish(checksum, auth, ad, adlen, mlen, rtk, c + mlen);
+        return mlen + 16;
+    }
+
+    bool open(const uint8_t *nonce, const uint8_t *ad, size_t adlen, const uint8_t *c, size_t clen, uint8_t *m, WorkStealingPool *pool) const
+    {
+        if (clen < 16)
+            return false;
+        uint8_t rtk[R][8], checksum[16], auth[16], pad[1][16], tag[16];
+        size_t mlen = clen - 16, full = mlen / 16, rest = mlen % 16;
+        nonce_schedule(nonce, rtk);
+        bulk(c, m, full, true, ad, adlen / 16, rtk, checksum, auth, pool);
+        if (rest > 0)
+        {
+            memset(pad[0], 0, 16);
+            tbc(pad, full, 1, rtk);
+            for (size_t i = 0; i < rest; i++)
+            {
+                m[16 * full + i] = c[16 * full + i] ^ pad[0][i];
+                checksum[i] ^= m[16 * full + i];
+            }
+            checksum[rest] ^= 0x80;
+        }
+        finish(checksum, auth, ad, adlen, mlen, rtk, tag);
+        uint8_t diff = 0;
+        for (uint8_t i = 0; i < 16; i++)
+            diff |= tag[i] ^ c[mlen + i];
+        if (diff != 0)
+            memset(m, 0, mlen);
+        return diff == 0;
+    }
+
+    Member member_;
+    const Kernels &kernels_;
+    uint8_t key_[16];
+};
+
+} // namespace skinny
+
+#endif
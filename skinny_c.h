@@ -0,0 +1,94 @@
+/*
+ * C interface of libskinny
+ * Date: Oct 18, 2026
+*/
+// Stable C ABI over the header-only library, built as libskinny.so and libskinny.a
+// (make lib). A skinny_key is an opaque expanded tweakey of one of the four variants;
+// blocks and tweakey lanes are 16 cells, one cell per byte (the low 4 bits for Skinny-64),
+// in the order shown in the README, and batches are contiguous arrays of such blocks.
+// The library keeps no mutable global state: the kernels are chosen once per variant on
+// first use (thread-safe), and a key is only read after skinny_key_create(), so any number
+// of threads may use the same key at once. Functions that can fail return SKINNY_OK or
+// a negative SKINNY_ERROR_* code.
+
+#ifndef SKINNY_C_H
+#define SKINNY_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(SKINNY_BUILD_LIBRARY) && defined(__GNUC__)
+#define SKINNY_API __attribute__((visibility("default")))
+#else
+#define SKINNY_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bumped when a function or a struct of this header changes incompatibly
+#define SKINNY_ABI_VERSION 1
+
+typedef enum skinny_variant
+{
+    SKINNY_64_128 = 0,
+    SKINNY_64_192 = 1,
+    SKINNY_128_256 = 2,
+    SKINNY_128_384 = 3
+} skinny_variant;
+
+enum
+{
+    SKINNY_OK = 0,
+    SKINNY_ERROR_VARIANT = -1,  // not one of the skinny_variant values
+    SKINNY_ERROR_ARGUMENT = -2, // NULL pointer where data is required
+    SKINNY_ERROR_MEMORY = -3    // allocation failed
+};
+
+typedef struct skinny_key skinny_key;
+
+// The variant and the batch kernels its calls go through
+typedef struct skinny_kernel_info
+{
+    int block_bits;
+    int tweakey_bits;
+    int rounds;
+    int lanes;          // tweakey lanes of 16 cells (TK1, TK2, TK3)
+    const char *kernel; // "scalar", "ssse3", "avx2" or "avx512"
+} skinny_kernel_info;
+
+SKINNY_API int skinny_abi_version(void);
+SKINNY_API const char *skinny_strerror(int error);
+SKINNY_API int skinny_kernel_info_get(skinny_variant variant, skinny_kernel_info *info);
+
+// tweakey holds lanes x 16 cells, TK1 first. skinny_key_create() stores the new key in
+// *key and returns SKINNY_OK, or leaves *key NULL and returns SKINNY_ERROR_VARIANT,
+// SKINNY_ERROR_ARGUMENT or SKINNY_ERROR_MEMORY. skinny_key_new() is the same returning
+// the key, NULL on any error. skinny_key_free(NULL) does nothing.
+SKINNY_API int skinny_key_create(skinny_variant variant, const uint8_t *tweakey, skinny_key **key);
+SKINNY_API skinny_key *skinny_key_new(skinny_variant variant, const uint8_t *tweakey);
+SKINNY_API void skinny_key_free(skinny_key *key);
+// The skinny_variant of the key, SKINNY_ERROR_ARGUMENT for NULL
+SKINNY_API int skinny_key_variant(const skinny_key *key);
+
+// One block of 16 cells
+SKINNY_API int skinny_encrypt_block(const skinny_key *key, const uint8_t *plaintext, uint8_t *ciphertext);
+SKINNY_API int skinny_decrypt_block(const skinny_key *key, uint8_t *plaintext, const uint8_t *ciphertext);
+
+// blocks blocks of 16 cells through the fastest batch kernels of the CPU
+SKINNY_API int skinny_encrypt(const skinny_key *key, const uint8_t *plaintext, uint8_t *ciphertext, size_t blocks);
+SKINNY_API int skinny_decrypt(const skinny_key *key, uint8_t *plaintext, const uint8_t *ciphertext, size_t blocks);
+
+// Every block under its own tweakey: tweakeys holds blocks x lanes x 16 cells, the
+// tweakey schedules run bitsliced with the blocks
+SKINNY_API int skinny_encrypt_multikey(skinny_variant variant, const uint8_t *tweakeys, const uint8_t *plaintext,
+                                       uint8_t *ciphertext, size_t blocks);
+SKINNY_API int skinny_decrypt_multikey(skinny_variant variant, const uint8_t *tweakeys, uint8_t *plaintext,
+                                       const uint8_t *ciphertext, size_t blocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Multithreaded bulk CTR-mode encryption with the Skinny ciphers
+ * Date: Oct 17, 2026
+*/
+// Ctr<Cipher>::crypt() XORs the keystream into a buffer, in place or out of place; block i of the stream is
+// the encryption of counter i, i.e. the index of the block. The counter either
+// - is added to the nonce block (COUNTER_IN_BLOCK): every block is encrypted under the same
+//   tweakey, in batches through the kernels of select_kernels(), or
+// - becomes TK1 (COUNTER_IN_TK1), the remaining lanes being the key: the nonce block is
+//   encrypted under a new TK1 per block, in batches through the per-block TK1 kernels.
+// Counters are written into the 16 cells with cell 15 least significant. The buffer is cut
+// into chunks of CHUNK_BLOCKS blocks, one task each on a WorkStealingPool.
+// A Skinny-64 block covers 8 bytes of data, cell 2k in the high nibble of byte k.
+
+#ifndef SKINNY_CTR_H
+#define SKINNY_CTR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include "skinny_dispatch.h"
+#include "work_pool.h"
+
+namespace skinny
+{
+
+enum Counter
+{
+    COUNTER_IN_BLOCK,
+    COUNTER_IN_TK1
+};
+
+template <class Cipher>
+class Ctr
+{
+public:
+    static constexpr int R = Cipher::ROUNDS;
+    static constexpr int BLOCK_BYTES = Cipher::BLOCK_BITS / 8;
+    // Blocks per task: a multiple of every batch kernel, 16 KiB (Skinny-64) or 32 KiB of data
+    static constexpr size_t CHUNK_BLOCKS = 2048;
+
+    // tweakey holds the LANES lanes; with COUNTER_IN_TK1 lane 0 is ignored
+    Ctr(const uint8_t tweakey[][16], const uint8_t nonce[16], Counter counter = COUNTER_IN_BLOCK)
+        : counter_(counter), kernels_(select_kernels<Cipher>())
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            nonce_[i] = nonce[i] & Cipher::CELL_MASK;
+        if (counter_ == COUNTER_IN_BLOCK)
+            kernels_.tweakey_schedule(tweakey, rtk_);
+        else
+        {
+            // encrypt_tk1() takes the round tweakeys of the key lanes with TK1 = 0
+            uint8_t tk[Cipher::LANES][16];
+            memset(tk[0], 0, 16);
+            memcpy(tk[1], tweakey[1], 16 * (Cipher::LANES - 1));
+            kernels_.tweakey_schedule(tk, rtk_);
+        }
+    }
+
+    // Blocks first_block, first_block + 1, ... of the keystream on the pool; a partial last
+    // block uses the leading bytes of its keystream block
+    void crypt(uint8_t *data, size_t bytes, uint64_t first_block, WorkStealingPool &pool) const
+    {
+        crypt(data, data, bytes, first_block, pool);
+    }
+
+    // Same on the calling thread only
+    void crypt(uint8_t *data, size_t bytes, uint64_t first_block = 0) const
+    {
+        crypt(data, data, bytes, first_block);
+    }
+
+    // Out of place: out = in ^ keystream, in and out are either the same buffer or disjoint
+    void crypt(const uint8_t *in, uint8_t *out, size_t bytes, uint64_t first_block, WorkStealingPool &pool) const
+    {
+        const size_t chunk_bytes = CHUNK_BLOCKS * BLOCK_BYTES;
+        pool.run((bytes + chunk_bytes - 1) / chunk_bytes, [&](size_t c) {
+            crypt_chunk(in + c * chunk_bytes, out + c * chunk_bytes, std::min(chunk_bytes, bytes - c * chunk_bytes), first_block + c * CHUNK_BLOCKS);
+        });
+    }
+
+    void crypt(const uint8_t *in, uint8_t *out, size_t bytes, uint64_t first_block = 0) const
+    {
+        const size_t chunk_bytes = CHUNK_BLOCKS * BLOCK_BYTES;
+        for (size_t c = 0; c * chunk_bytes < bytes; c++)
+            crypt_chunk(in + c * chunk_bytes, out + c * chunk_bytes, std::min(chunk_bytes, bytes - c * chunk_bytes), first_block + c * CHUNK_BLOCKS);
+    }
+
+    // cells = base + counter, modulo 2^BLOCK_BITS
+    static void add_counter(const uint8_t base[16], uint64_t counter, uint8_t cells[16])
+    {
+        unsigned carry = 0;
+        for (int i = 15; i >= 0; i--)
+        {
+            unsigned sum = base[i] + static_cast<unsigned>(counter & Cipher::CELL_MASK) + carry;
+            cells[i] = static_cast<uint8_t>(sum & Cipher::CELL_MASK);
+            carry = sum >> Cipher::CELL_BITS;
+            counter >>= Cipher::CELL_BITS;
+        }
+    }
+
+private:
+    static void xor_keystream(const uint8_t keystream[16], const uint8_t *in, uint8_t *out, size_t bytes)
+    {
+        if constexpr (Cipher::CELL_BITS == 4)
+            for (size_t k = 0; k < bytes; k++)
+                out[k] = in[k] ^ static_cast<uint8_t>((keystream[2 * k] << 4) | keystream[2 * k + 1]);
+        else
+            for (size_t k = 0; k < bytes; k++)
+                out[k] = in[k] ^ keystream[k];
+    }
+
+    void crypt_chunk(const uint8_t *in, uint8_t *out, size_t bytes, uint64_t block) const
+    {
+        const size_t blocks = (bytes + BLOCK_BYTES - 1) / BLOCK_BYTES;
+        uint8_t counters[CHUNK_BLOCKS][16];
+        uint8_t stream[CHUNK_BLOCKS][16];
+        if (counter_ == COUNTER_IN_BLOCK)
+        {
+            add_counter(nonce_, block, counters[0]);
+            for (size_t j = 1; j < blocks; j++)
+                add_counter(counters[j - 1], 1, counters[j]);
+            kernels_.encrypt(counters, stream, blocks, rtk_);
+        }
+        else
+        {
+            // counters holds the TK1 of every block, stream the nonce block it encrypts
+            static const uint8_t zero[16] = {0};
+            add_counter(zero, block, counters[0]);
+            for (size_t j = 1; j < blocks; j++)
+                add_counter(counters[j - 1], 1, counters[j]);
+            for (size_t j = 0; j < blocks; j++)
+                memcpy(stream[j], nonce_, 16);
+            kernels_.encrypt_tk1(stream, stream, counters, blocks, rtk_);
+        }
+        for (size_t j = 0; j < blocks; j++)
+            xor_keystream(stream[j], in + j * BLOCK_BYTES, out + j * BLOCK_BYTES, std::min<size_t>(BLOCK_BYTES, bytes - j * BLOCK_BYTES));
+    }
+
+    Counter counter_;
+    const Kernels &kernels_;
+    uint8_t nonce_[16];
+    uint8_t rtk_[R][8];
+};
+
+} // namespace skinny
+
+#endif
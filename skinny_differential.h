@@ -0,0 +1,143 @@
+/*
+ * Experimental differential probabilities of reduced-round Skinny
+ * Date: Oct 17, 2026
+*/
+// estimate_differential<Cipher>() counts how many of the sampled pairs
+// (P, P ^ input) under tweakeys (TK, TK ^ tweakey) lead to the ciphertext difference
+// output after the given number of rounds. Pairs are drawn by TASK_PAIRS per task on a
+// WorkStealingPool: every task draws a fresh random tweakey and its plaintexts from its
+// own xoshiro256** generator, seeded from the seed and the task index, so the result does
+// not depend on the number of threads. Both halves of the pairs go through the
+// reduced-round batch kernels of select_kernels().
+
+#ifndef SKINNY_DIFFERENTIAL_H
+#define SKINNY_DIFFERENTIAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include "skinny_dispatch.h"
+#include "work_pool.h"
+#include "xoshiro256.h"
+
+namespace skinny
+{
+
+// Differences as cells, one per byte
+struct Differential
+{
+    int rounds;
+    uint8_t input[16];
+    uint8_t output[16];
+    uint8_t tweakey[3][16];
+};
+
+struct DifferentialEstimate
+{
+    uint64_t samples;
+    uint64_t matches;
+    double probability;
+    double log2_probability; // -infinity without a match
+    double lower, upper;     // confidence interval of the probability
+};
+
+// Called after every task with the pairs done so far and their matches
+typedef std::function<void(uint64_t done, uint64_t matches)> DifferentialProgress;
+
+// Wilson score interval for matches out of samples; z = 1.96 for 95 % confidence
+inline void wilson_interval(uint64_t matches, uint64_t samples, double z, double &lower, double &upper)
+{
+    double n = static_cast<double>(samples), p = static_cast<double>(matches) / n;
+    double center = (p + z * z / (2 * n)) / (1 + z * z / n);
+    double half = z * sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+    lower = std::max(0.0, center - half);
+    upper = std::min(1.0, center + half);
+}
+
+template <class Cipher>
+DifferentialEstimate estimate_differential(const Differential &d, uint64_t samples, uint64_t seed, WorkStealingPool &pool,
+                                           double z = 1.959964, const DifferentialProgress &progress = DifferentialProgress())
+{
+    static constexpr int R = Cipher::ROUNDS;
+    static constexpr uint64_t TASK_PAIRS = 1 << 16;
+    static constexpr size_t BATCH = 2048;
+    const Kernels &kernels = select_kernels<Cipher>();
+    bool tweakey_difference = false;
+    for (int l = 0; l < Cipher::LANES; l++)
+        for (uint8_t i = 0; i < 16; i++)
+            tweakey_difference |= (d.tweakey[l][i] & Cipher::CELL_MASK) != 0;
+    std::atomic<uint64_t> done(0), matches(0);
+    std::mutex progress_lock;
+    pool.run((samples + TASK_PAIRS - 1) / TASK_PAIRS, [&](size_t task) {
+        uint8_t pt[BATCH][16], pt2[BATCH][16], ct[BATCH][16], ct2[BATCH][16];
+        uint8_t tk[Cipher::LANES][16], tk2[Cipher::LANES][16], rtk[R][8], rtk2[R][8];
+        uint64_t words[2], expected[2], found = 0;
+        Xoshiro256 rng(seed, task);
+        memcpy(expected, d.output, 16);
+        for (int l = 0; l < Cipher::LANES; l++)
+        {
+            words[0] = rng.next();
+            words[1] = rng.next();
+            memcpy(tk[l], words, 16);
+            for (uint8_t i = 0; i < 16; i++)
+            {
+                tk[l][i] &= Cipher::CELL_MASK;
+                tk2[l][i] = tk[l][i] ^ d.tweakey[l][i];
+            }
+        }
+        kernels.tweakey_schedule(tk, rtk);
+        if (tweakey_difference)
+            kernels.tweakey_schedule(tk2, rtk2);
+        const uint64_t first = task * TASK_PAIRS, pairs = std::min(TASK_PAIRS, samples - first);
+        for (uint64_t start = 0; start < pairs; start += BATCH)
+        {
+            size_t n = static_cast<size_t>(std::min<uint64_t>(BATCH, pairs - start));
+            for (size_t j = 0; j < n; j++)
+            {
+                words[0] = rng.next();
+                words[1] = rng.next();
+                memcpy(pt[j], words, 16);
+                for (uint8_t i = 0; i < 16; i++)
+                {
+                    pt[j][i] &= Cipher::CELL_MASK;
+                    pt2[j][i] = pt[j][i] ^ d.input[i];
+                }
+            }
+            kernels.encrypt_rounds(d.rounds, pt, ct, n, rtk);
+            kernels.encrypt_rounds(d.rounds, pt2, ct2, n, tweakey_difference ? rtk2 : rtk);
+            for (size_t j = 0; j < n; j++)
+            {
+                uint64_t a[2], b[2];
+                memcpy(a, ct[j], 16);
+                memcpy(b, ct2[j], 16);
+                found += ((a[0] ^ b[0]) == expected[0]) & ((a[1] ^ b[1]) == expected[1]);
+            }
+        }
+        uint64_t total_matches = matches += found;
+        uint64_t total_done = done += pairs;
+        if (progress)
+        {
+            std::lock_guard<std::mutex> guard(progress_lock);
+            progress(total_done, total_matches);
+        }
+    });
+    DifferentialEstimate e;
+    e.samples = samples;
+    e.matches = matches;
+    e.probability = (samples == 0) ? 0 : static_cast<double>(e.matches) / samples;
+    e.log2_probability = (e.matches == 0) ? -INFINITY : log2(e.probability);
+    e.lower = 0;
+    e.upper = 1;
+    if (samples != 0)
+        wilson_interval(e.matches, samples, z, e.lower, e.upper);
+    return e;
+}
+
+} // namespace skinny
+
+#endif
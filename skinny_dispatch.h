@@ -0,0 +1,469 @@
+/*
+ * Run-time selection of the fastest Skinny kernels for the host CPU
+ * Date: Oct 17, 2026
+*/
+// select_kernels<Cipher>() probes the CPU on first use and returns the function-pointer
+// table of the fastest kernels it can run for that Skinny variant (AVX-512, AVX2, SSSE3
+// or portable code). SKINNY_KERNEL=scalar|ssse3|avx2|avx512 in the environment forces a
+// kernel for benchmarking and debugging; it is ignored if the CPU cannot run it or the
+// variant has no such kernel, and the name field of the table tells which one is bound.
+
+#ifndef SKINNY_DISPATCH_H
+#define SKINNY_DISPATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "skinny.h"
+#include "skinny64_kernels.h"
+#include "skinny128_kernels.h"
+
+namespace skinny
+{
+
+enum Isa
+{
+    ISA_SCALAR,
+    ISA_SSSE3,
+    ISA_AVX2,
+    ISA_AVX512,
+    ISA_COUNT
+};
+
+constexpr const char *isa_name(int isa)
+{
+    switch (isa)
+    {
+    case ISA_SCALAR:
+        return "scalar";
+    case ISA_SSSE3:
+        return "ssse3";
+    case ISA_AVX2:
+        return "avx2";
+    case ISA_AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+inline bool cpu_supports(int isa)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    switch (isa)
+    {
+    case ISA_SCALAR:
+        return true;
+    case ISA_SSSE3:
+        return __builtin_cpu_supports("ssse3");
+    case ISA_AVX2:
+        return __builtin_cpu_supports("avx2");
+    case ISA_AVX512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    }
+    return false;
+#else
+    return isa == ISA_SCALAR;
+#endif
+}
+
+// Kernels of one Skinny variant. tweakey_schedule() expands the master tweakey (one lane
+// of 16 cells per TK) into round tweakeys for all rounds, and encrypt()/decrypt() apply
+// them to any number of blocks. encrypt_rounds() stops after the first rounds (at most the
+// full count) for reduced-round experiments. encrypt_tk1()/decrypt_tk1() take a TK1 per
+// block, tk then holds the round tweakeys of the other lanes with TK1 = 0.
+struct Kernels
+{
+    int isa;
+    const char *name;
+    int block_bits;
+    int tweakey_bits;
+    int rounds;
+    void (*tweakey_schedule)(const uint8_t tk[][16], uint8_t round_tweakey[][8]);
+    void (*encrypt)(const uint8_t plaintext[][16], uint8_t ciphertext[][16], size_t blocks, const uint8_t tk[][8]);
+    void (*decrypt)(uint8_t plaintext[][16], const uint8_t ciphertext[][16], size_t blocks, const uint8_t tk[][8]);
+    void (*encrypt_rounds)(int rounds, const uint8_t plaintext[][16], uint8_t ciphertext[][16], size_t blocks, const uint8_t tk[][8]);
+    void (*encrypt_tk1)(const uint8_t plaintext[][16], uint8_t ciphertext[][16], const uint8_t tk1[][16], size_t blocks, const uint8_t tk[][8]);
+    void (*decrypt_tk1)(uint8_t plaintext[][16], const uint8_t ciphertext[][16], const uint8_t tk1[][16], size_t blocks, const uint8_t tk[][8]);
+};
+
+// Splits a batch over the widest kernels of the given ISA level and below. Skinny-64 has
+// byte-sliced SIMD kernels down to SSSE3, bitsliced and packed scalar code; Skinny-128
+// has bitsliced AVX-512/AVX2 kernels and the fixsliced scalar code (no SSSE3 kernel).
+// Per-block TK1 batches use the bitsliced Skinny-128 kernels, everything else goes block
+// by block through the row-as-word code.
+template <class Cipher, int Level>
+struct BatchKernels
+{
+    static const int R = Cipher::ROUNDS;
+
+    static void tweakey_schedule(const uint8_t tk[][16], uint8_t round_tweakey[][8])
+    {
+        // Row-as-word schedule, stored back as cells
+        typename Cipher::Key key;
+        Cipher::expand_key(tk, key);
+        for (int r = 0; r < R; r++)
+            for (uint8_t i = 0; i < 8; i++)
+                round_tweakey[r][i] = static_cast<uint8_t>((key.rtk[r][i >> 2] >> (Cipher::CELL_BITS * (i & 0x3))) & Cipher::CELL_MASK);
+    }
+
+    static void encrypt(const uint8_t plaintext[][16], uint8_t ciphertext[][16], size_t blocks, const uint8_t tk[][8])
+    {
+        encrypt_rounds(R, plaintext, ciphertext, blocks, tk);
+    }
+
+    static void encrypt_rounds(int rounds, const uint8_t plaintext[][16], uint8_t ciphertext[][16], size_t blocks, const uint8_t tk[][8])
+    {
+        size_t j = 0;
+        if constexpr (Cipher::BLOCK_BITS == 64)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            if constexpr (Level >= ISA_AVX512)
+                for (; j + 64 <= blocks; j += 64)
+                    kernels64::enc_avx512(rounds, plaintext + j, ciphertext + j, tk);
+            if constexpr (Level >= ISA_AVX2)
+                for (; j + 32 <= blocks; j += 32)
+                    kernels64::enc_avx2(rounds, plaintext + j, ciphertext + j, tk);
+            if constexpr (Level >= ISA_SSSE3)
+                for (; j + 16 <= blocks; j += 16)
+                    kernels64::enc_ssse3(rounds, plaintext + j, ciphertext + j, tk);
+#endif
+            for (; j + 64 <= blocks; j += 64)
+                kernels64::enc_bitsliced(rounds, plaintext + j, ciphertext + j, tk);
+            if (j < blocks)
+            {
+                uint64_t rtk[R];
+                kernels64::tweakey_schedule_packed(rounds, tk, rtk);
+                for (; j < blocks; j++)
+                    kernels64::unpack_state(kernels64::enc_packed(rounds, kernels64::pack_state(plaintext[j]), rtk), ciphertext[j]);
+            }
+        }
+        else
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            if constexpr (Level >= ISA_AVX512)
+                for (; j + 512 <= blocks; j += 512)
+                    kernels128::enc_bitsliced_avx512(rounds, plaintext + j, ciphertext + j, tk);
+            if constexpr (Level >= ISA_AVX2)
+                for (; j + 256 <= blocks; j += 256)
+                    kernels128::enc_bitsliced_avx2(rounds, plaintext + j, ciphertext + j, tk);
+#endif
+            if (j < blocks)
+                fixsliced(rounds, plaintext + j, ciphertext + j, blocks - j, tk, true);
+        }
+    }
+
+    static void decrypt(uint8_t plaintext[][16], const uint8_t ciphertext[][16], size_t blocks, const uint8_t tk[][8])
+    {
+        size_t j = 0;
+        if constexpr (Cipher::BLOCK_BITS == 64)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            if constexpr (Level >= ISA_AVX512)
+                for (; j + 64 <= blocks; j += 64)
+                    kernels64::dec_avx512(R, plaintext + j, ciphertext + j, tk);
+            if constexpr (Level >= ISA_AVX2)
+                for (; j + 32 <= blocks; j += 32)
+                    kernels64::dec_avx2(R, plaintext + j, ciphertext + j, tk);
+            if constexpr (Level >= ISA_SSSE3)
+                for (; j + 16 <= blocks; j += 16)
+                    kernels64::dec_ssse3(R, plaintext + j, ciphertext + j, tk);
+#endif
+            for (; j + 64 <= blocks; j += 64)
+                kernels64::dec_bitsliced(R, plaintext + j, ciphertext + j, tk);
+            if (j < blocks)
+            {
+                uint64_t rtk[R];
+                kernels64::tweakey_schedule_packed(R, tk, rtk);
+                for (; j < blocks; j++)
+                    kernels64::unpack_state(kernels64::dec_packed(R, kernels64::pack_state(ciphertext[j]), rtk), plaintext[j]);
+            }
+        }
+        else
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            if constexpr (Level >= ISA_AVX512)
+                for (; j + 512 <= blocks; j += 512)
+                    kernels128::dec_bitsliced_avx512(R, plaintext + j, ciphertext + j, tk);
+            if constexpr (Level >= ISA_AVX2)
+                for (; j + 256 <= blocks; j += 256)
+                    kernels128::dec_bitsliced_avx2(R, plaintext + j, ciphertext + j, tk);
+#endif
+            if (j < blocks)
+                fixsliced(R, ciphertext + j, plaintext + j, blocks - j, tk, false);
+        }
+    }
+
+    static void encrypt_tk1(const uint8_t plaintext[][16], uint8_t ciphertext[][16], const uint8_t tk1[][16], size_t blocks, const uint8_t tk[][8])
+    {
+        size_t j = 0;
+#if defined(__x86_64__) || defined(__i386__)
+        if constexpr (Cipher::BLOCK_BITS == 128 && Level >= ISA_AVX512)
+            for (; j + 512 <= blocks; j += 512)
+                kernels128::enc_bitsliced_avx512(R, plaintext + j, ciphertext + j, tk, tk1 + j);
+        if constexpr (Cipher::BLOCK_BITS == 128 && Level >= ISA_AVX2)
+            for (; j + 256 <= blocks; j += 256)
+                kernels128::enc_bitsliced_avx2(R, plaintext + j, ciphertext + j, tk, tk1 + j);
+#endif
+        if (j < blocks)
+        {
+            typename Cipher::Key base, key;
+            key_rows(tk, base);
+            for (; j < blocks; j++)
+            {
+                Cipher::add_tk1(base.rtk, tk1[j], key);
+                Cipher::encrypt(key, plaintext[j], ciphertext[j]);
+            }
+        }
+    }
+
+    static void decrypt_tk1(uint8_t plaintext[][16], const uint8_t ciphertext[][16], const uint8_t tk1[][16], size_t blocks, const uint8_t tk[][8])
+    {
+        size_t j = 0;
+#if defined(__x86_64__) || defined(__i386__)
+        if constexpr (Cipher::BLOCK_BITS == 128 && Level >= ISA_AVX512)
+            for (; j + 512 <= blocks; j += 512)
+                kernels128::dec_bitsliced_avx512(R, plaintext + j, ciphertext + j, tk, tk1 + j);
+        if constexpr (Cipher::BLOCK_BITS == 128 && Level >= ISA_AVX2)
+            for (; j + 256 <= blocks; j += 256)
+                kernels128::dec_bitsliced_avx2(R, plaintext + j, ciphertext + j, tk, tk1 + j);
+#endif
+        if (j < blocks)
+        {
+            typename Cipher::Key base, key;
+            key_rows(tk, base);
+            for (; j < blocks; j++)
+            {
+                Cipher::add_tk1(base.rtk, tk1[j], key);
+                Cipher::decrypt(key, plaintext[j], ciphertext[j]);
+            }
+        }
+    }
+
+private:
+    // Round tweakeys in cells back to the row format of Cipher::Key
+    static void key_rows(const uint8_t tk[][8], typename Cipher::Key &key)
+    {
+        for (int r = 0; r < R; r++)
+            for (uint8_t k = 0; k < 2; k++)
+            {
+                key.rtk[r][k] = 0;
+                for (uint8_t c = 0; c < 4; c++)
+                    key.rtk[r][k] |= static_cast<typename Cipher::row_t>((tk[r][4 * k + c] & Cipher::CELL_MASK) << (Cipher::CELL_BITS * c));
+            }
+    }
+
+    static void fixsliced(int rounds, const uint8_t in[][16], uint8_t out[][16], size_t blocks, const uint8_t tk[][8], bool encrypt)
+    {
+        // Four blocks per uint64_t, the last group padded
+        uint64_t rtk_fs[R][8];
+        uint8_t pad_in[4][16], pad_out[4][16];
+        size_t j = 0;
+        kernels128::tweakey_schedule_fixsliced(rounds, tk, rtk_fs);
+        for (; j + 4 <= blocks; j += 4)
+        {
+            if (encrypt)
+                kernels128::enc_fixsliced(rounds, in + j, out + j, rtk_fs);
+            else
+                kernels128::dec_fixsliced(rounds, out + j, in + j, rtk_fs);
+        }
+        if (j < blocks)
+        {
+            memset(pad_in, 0, sizeof(pad_in));
+            memcpy(pad_in, in + j, 16 * (blocks - j));
+            if (encrypt)
+                kernels128::enc_fixsliced(rounds, pad_in, pad_out, rtk_fs);
+            else
+                kernels128::dec_fixsliced(rounds, pad_out, pad_in, rtk_fs);
+            memcpy(out + j, pad_out, 16 * (blocks - j));
+        }
+    }
+};
+
+template <class Cipher, int Level>
+constexpr Kernels make_kernels()
+{
+    return Kernels{Level, isa_name(Level), Cipher::BLOCK_BITS, Cipher::TWEAKEY_BITS, Cipher::ROUNDS,
+                   BatchKernels<Cipher, Level>::tweakey_schedule,
+                   BatchKernels<Cipher, Level>::encrypt,
+                   BatchKernels<Cipher, Level>::decrypt,
+                   BatchKernels<Cipher, Level>::encrypt_rounds,
+                   BatchKernels<Cipher, Level>::encrypt_tk1,
+                   BatchKernels<Cipher, Level>::decrypt_tk1};
+}
+
+// Kernels of the given ISA for the variant, or NULL if there are none (no SSSE3 kernels
+// for Skinny-128, nothing but scalar code off x86). Does not check the CPU.
+template <class Cipher>
+const Kernels *kernels_for(int isa)
+{
+    static const Kernels table[ISA_COUNT] = {make_kernels<Cipher, ISA_SCALAR>(), make_kernels<Cipher, ISA_SSSE3>(),
+                                             make_kernels<Cipher, ISA_AVX2>(), make_kernels<Cipher, ISA_AVX512>()};
+    if (isa < 0 || isa >= ISA_COUNT)
+        return NULL;
+#if defined(__x86_64__) || defined(__i386__)
+    if (isa == ISA_SSSE3 && Cipher::BLOCK_BITS != 64)
+        return NULL;
+#else
+    if (isa != ISA_SCALAR)
+        return NULL;
+#endif
+    return &table[isa];
+}
+
+template <class Cipher>
+const Kernels *choose_kernels()
+{
+    const char *forced = getenv("SKINNY_KERNEL");
+    if (forced != NULL)
+        for (int isa = 0; isa < ISA_COUNT; isa++)
+            if (strcmp(forced, isa_name(isa)) == 0 && cpu_supports(isa) && kernels_for<Cipher>(isa) != NULL)
+                return kernels_for<Cipher>(isa);
+    for (int isa = ISA_COUNT - 1; isa > ISA_SCALAR; isa--)
+        if (cpu_supports(isa) && kernels_for<Cipher>(isa) != NULL)
+            return kernels_for<Cipher>(isa);
+    return kernels_for<Cipher>(ISA_SCALAR);
+}
+
+// Chosen once per variant (thread-safe), the same table is returned afterwards
+template <class Cipher>
+const Kernels &select_kernels()
+{
+    static const Kernels *const selected = choose_kernels<Cipher>();
+    return *selected;
+}
+
+// Trace policy for one chunk of a traced batch: block indices relative to the whole batch
+template <class Trace>
+struct OffsetTrace
+{
+    static constexpr bool ENABLED = Trace::ENABLED;
+    const Trace &trace;
+    size_t offset;
+
+    void operator()(int round, TraceStep step, size_t first, size_t count, const uint8_t state[][16]) const
+    {
+        trace(round, step, offset + first, count, state);
+    }
+};
+
+// The first rounds rounds of encrypt_rounds() and their inverse with a trace policy (see
+// NoTrace in skinny.h). The byte-sliced, packed and fixsliced kernels merge steps, so the
+// blocks go through the bitsliced kernels instead: 64 at a time for Skinny-64, 512 or 256
+// for Skinny-128 if the selected kernels are AVX-512 or AVX2; the rest block by block
+// through enc_rounds()/dec_rounds().
+template <class Cipher, class Trace>
+void encrypt_traced(int rounds, const uint8_t plaintext[][16], uint8_t ciphertext[][16], size_t blocks, const uint8_t tk[][8], const Trace &trace)
+{
+    size_t j = 0;
+    if constexpr (Cipher::BLOCK_BITS == 64)
+    {
+        for (; j + 64 <= blocks; j += 64)
+            kernels64::enc_bitsliced(rounds, plaintext + j, ciphertext + j, tk, OffsetTrace<Trace>{trace, j});
+    }
+    else
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        const int isa = select_kernels<Cipher>().isa;
+        if (isa >= ISA_AVX512)
+            for (; j + 512 <= blocks; j += 512)
+                kernels128::enc_bitsliced_avx512(rounds, plaintext + j, ciphertext + j, tk, NULL, OffsetTrace<Trace>{trace, j});
+        if (isa >= ISA_AVX2)
+            for (; j + 256 <= blocks; j += 256)
+                kernels128::enc_bitsliced_avx2(rounds, plaintext + j, ciphertext + j, tk, NULL, OffsetTrace<Trace>{trace, j});
+#endif
+    }
+    for (; j < blocks; j++)
+        Cipher::enc_rounds(0, rounds, plaintext[j], ciphertext[j], tk, OffsetTrace<Trace>{trace, j});
+}
+
+template <class Cipher, class Trace>
+void decrypt_traced(int rounds, uint8_t plaintext[][16], const uint8_t ciphertext[][16], size_t blocks, const uint8_t tk[][8], const Trace &trace)
+{
+    size_t j = 0;
+    if constexpr (Cipher::BLOCK_BITS == 64)
+    {
+        for (; j + 64 <= blocks; j += 64)
+            kernels64::dec_bitsliced(rounds, plaintext + j, ciphertext + j, tk, OffsetTrace<Trace>{trace, j});
+    }
+    else
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        const int isa = select_kernels<Cipher>().isa;
+        if (isa >= ISA_AVX512)
+            for (; j + 512 <= blocks; j += 512)
+                kernels128::dec_bitsliced_avx512(rounds, plaintext + j, ciphertext + j, tk, NULL, OffsetTrace<Trace>{trace, j});
+        if (isa >= ISA_AVX2)
+            for (; j + 256 <= blocks; j += 256)
+                kernels128::dec_bitsliced_avx2(rounds, plaintext + j, ciphertext + j, tk, NULL, OffsetTrace<Trace>{trace, j});
+#endif
+    }
+    for (; j < blocks; j++)
+        Cipher::dec_rounds(0, rounds, plaintext[j], ciphertext[j], tk, OffsetTrace<Trace>{trace, j});
+}
+
+// Every block under its own tweakey: tweakey[j] holds the LANES lanes (TK1, TK2, TK3) of
+// block j. The tweakey schedules run bitsliced with the blocks, through the multi-key
+// kernels: 64 blocks at a time for Skinny-64, 512 or 256 for Skinny-128 if the selected
+// kernels are AVX-512 or AVX2; the rest block by block with the on-the-fly schedule.
+template <class Cipher>
+void encrypt_multikey(int rounds, const uint8_t plaintext[][16], uint8_t ciphertext[][16], size_t blocks, const uint8_t tweakey[][Cipher::LANES][16])
+{
+    typename Cipher::TweakeyState state;
+    size_t j = 0;
+    if constexpr (Cipher::BLOCK_BITS == 64)
+    {
+        for (; j + 64 <= blocks; j += 64)
+            kernels64::enc_bitsliced_multikey<Cipher::LANES>(rounds, plaintext + j, ciphertext + j, tweakey + j);
+    }
+    else
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        const int isa = select_kernels<Cipher>().isa;
+        if (isa >= ISA_AVX512)
+            for (; j + 512 <= blocks; j += 512)
+                kernels128::enc_bitsliced_multikey_avx512<Cipher::LANES>(rounds, plaintext + j, ciphertext + j, tweakey + j);
+        if (isa >= ISA_AVX2)
+            for (; j + 256 <= blocks; j += 256)
+                kernels128::enc_bitsliced_multikey_avx2<Cipher::LANES>(rounds, plaintext + j, ciphertext + j, tweakey + j);
+#endif
+    }
+    for (; j < blocks; j++)
+    {
+        Cipher::load_tweakey(tweakey[j], state);
+        Cipher::enc_otf(rounds, plaintext[j], ciphertext[j], state);
+    }
+}
+
+template <class Cipher>
+void decrypt_multikey(int rounds, uint8_t plaintext[][16], const uint8_t ciphertext[][16], size_t blocks, const uint8_t tweakey[][Cipher::LANES][16])
+{
+    typename Cipher::TweakeyState state;
+    size_t j = 0;
+    if constexpr (Cipher::BLOCK_BITS == 64)
+    {
+        for (; j + 64 <= blocks; j += 64)
+            kernels64::dec_bitsliced_multikey<Cipher::LANES>(rounds, plaintext + j, ciphertext + j, tweakey + j);
+    }
+    else
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        const int isa = select_kernels<Cipher>().isa;
+        if (isa >= ISA_AVX512)
+            for (; j + 512 <= blocks; j += 512)
+                kernels128::dec_bitsliced_multikey_avx512<Cipher::LANES>(rounds, plaintext + j, ciphertext + j, tweakey + j);
+        if (isa >= ISA_AVX2)
+            for (; j + 256 <= blocks; j += 256)
+                kernels128::dec_bitsliced_multikey_avx2<Cipher::LANES>(rounds, plaintext + j, ciphertext + j, tweakey + j);
+#endif
+    }
+    for (; j < blocks; j++)
+    {
+        Cipher::load_tweakey(tweakey[j], state, rounds - 1);
+        Cipher::dec_otf(rounds, plaintext[j], ciphertext[j], state);
+    }
+}
+
+} // namespace skinny
+
+#endif
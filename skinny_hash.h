@@ -0,0 +1,241 @@
+/*
+ * SKINNY-tk3-Hash and SKINNY-tk2-Hash: sponges on the Skinny tweakey
+ * Date: Oct 18, 2026
+*/
+// The sponge state is the whole tweakey: 384 bits (TK1 || TK2 || TK3 of Skinny-128-384)
+// for SKINNY-tk3-Hash with a 128-bit rate, 256 bits (TK1 || TK2 of Skinny-128-256) for
+// SKINNY-tk2-Hash with a 32-bit rate. The permutation F encrypts the constant blocks
+// 0^128, 0^127 || 1 (and 0^126 || 10 for tk3) under the state as tweakey, and the
+// ciphertexts are the new state. The state starts as 0^r || 1 || 0^(c-1) (0x80 in the
+// first capacity byte), the message is padded with 10* (always at least one byte) and
+// absorbed into the rate, then 256 bits are squeezed, 128 bits (the first lane) per F for
+// both hashes, as in the reference code: SKINNY-tk2-Hash absorbs 32 bits at a time but
+// squeezes 128.
+// The rate sits in TK1, so every absorbed block changes the tweakey; F runs as one
+// expand_key() and 2 or 3 unrolled encryptions. hash_batch() hashes independent messages
+// together: each F of all active messages is one multi-key batch (encrypt_multikey(),
+// every block under its own tweakey), chunks of messages on a WorkStealingPool.
+
+#ifndef SKINNY_HASH_H
+#define SKINNY_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include "skinny_dispatch.h"
+#include "work_pool.h"
+
+namespace skinny
+{
+
+template <class Cipher>
+class SkinnyHash
+{
+    static_assert(Cipher::BLOCK_BITS == 128 && Cipher::LANES > 1, "SKINNY-Hash runs on Skinny-128-256 or Skinny-128-384");
+
+public:
+    static constexpr int LANES = Cipher::LANES;
+    static constexpr size_t STATE_BYTES = 16 * LANES;
+    static constexpr size_t RATE = (LANES == 3) ? 16 : 4;
+    static constexpr size_t SQUEEZE_BYTES = 16;
+    static const int DIGEST_BYTES = 32;
+    // Messages per multi-key chunk of hash_batch()
+    static constexpr size_t CHUNK_MESSAGES = 1024;
+
+    SkinnyHash() { reset(); }
+
+    void reset()
+    {
+        init_state(state_);
+        buf_len_ = 0;
+    }
+
+    void update(const uint8_t *data, size_t len)
+    {
+        while (len > 0)
+        {
+            size_t take = std::min(RATE - buf_len_, len);
+            memcpy(buf_ + buf_len_, data, take);
+            buf_len_ += take;
+            data += take;
+            len -= take;
+            if (buf_len_ == RATE)
+            {
+                absorb(state_, buf_, RATE);
+                permute(state_);
+                buf_len_ = 0;
+            }
+        }
+    }
+
+    // Pads the buffered bytes, squeezes the digest and resets for the next message
+    void final(uint8_t digest[DIGEST_BYTES])
+    {
+        absorb_padded(state_, buf_, buf_len_);
+        permute(state_);
+        squeeze(state_, digest);
+        reset();
+    }
+
+    static void hash(const uint8_t *m, size_t len, uint8_t digest[DIGEST_BYTES])
+    {
+        uint8_t state[STATE_BYTES];
+        init_state(state);
+        for (; len >= RATE; m += RATE, len -= RATE)
+        {
+            absorb(state, m, RATE);
+            permute(state);
+        }
+        absorb_padded(state, m, len);
+        permute(state);
+        squeeze(state, digest);
+    }
+
+    // digests[k] = hash(messages[k], lengths[k]); the messages are independent, so every
+    // F of a chunk of messages is one multi-key batch
+    static void hash_batch(const uint8_t *const messages[], const size_t lengths[], size_t count, uint8_t digests[][DIGEST_BYTES],
+                           WorkStealingPool *pool = NULL)
+    {
+        const size_t tasks = (count + CHUNK_MESSAGES - 1) / CHUNK_MESSAGES;
+        auto task = [&](size_t t) {
+            size_t first = t * CHUNK_MESSAGES;
+            hash_chunk(messages + first, lengths + first, std::min(CHUNK_MESSAGES, count - first), digests + first);
+        };
+        if (pool != NULL && tasks > 1)
+            pool->run(tasks, task);
+        else
+            for (size_t t = 0; t < tasks; t++)
+                task(t);
+    }
+
+    // F: the state is the tweakey, the new state the encryptions of 0, 1 (, 2)
+    static void permute(uint8_t state[STATE_BYTES])
+    {
+        uint8_t tk[LANES][16];
+        uint8_t block[16] = {0};
+        typename Cipher::Key key;
+        memcpy(tk, state, STATE_BYTES);
+        Cipher::expand_key(tk, key);
+        for (int l = 0; l < LANES; l++)
+        {
+            block[15] = static_cast<uint8_t>(l);
+            Cipher::encrypt(key, block, state + 16 * l);
+        }
+    }
+
+    static void init_state(uint8_t state[STATE_BYTES])
+    {
+        memset(state, 0, STATE_BYTES);
+        state[RATE] = 0x80;
+    }
+
+private:
+    uint8_t state_[STATE_BYTES];
+    uint8_t buf_[RATE];
+    size_t buf_len_;
+
+    static void absorb(uint8_t state[STATE_BYTES], const uint8_t *block, size_t len)
+    {
+        for (size_t i = 0; i < len; i++)
+            state[i] ^= block[i];
+    }
+
+    // The last len < RATE bytes followed by 0x80 and zeros
+    static void absorb_padded(uint8_t state[STATE_BYTES], const uint8_t *data, size_t len)
+    {
+        absorb(state, data, len);
+        state[len] ^= 0x80;
+    }
+
+    static void squeeze(uint8_t state[STATE_BYTES], uint8_t digest[DIGEST_BYTES])
+    {
+        for (size_t out = 0; out < DIGEST_BYTES; out += SQUEEZE_BYTES)
+        {
+            if (out > 0)
+                permute(state);
+            memcpy(digest + out, state, SQUEEZE_BYTES);
+        }
+    }
+
+    // F on n states at once: LANES blocks per state, each under that state as tweakey
+    static void permute_batch(uint8_t states[][STATE_BYTES], size_t n, uint8_t tweakeys[][LANES][16], uint8_t blocks[][16])
+    {
+        for (size_t k = 0; k < n; k++)
+            for (int l = 0; l < LANES; l++)
+            {
+                memcpy(tweakeys[LANES * k + l], states[k], STATE_BYTES);
+                memset(blocks[LANES * k + l], 0, 16);
+                blocks[LANES * k + l][15] = static_cast<uint8_t>(l);
+            }
+        encrypt_multikey<Cipher>(Cipher::ROUNDS, blocks, blocks, LANES * n, tweakeys);
+        for (size_t k = 0; k < n; k++)
+            memcpy(states[k], blocks[LANES * k], STATE_BYTES);
+    }
+
+    // Absorbs block b of every message that still has one: the active messages are
+    // compacted to the front, so every step is one dense batch
+    static void hash_chunk(const uint8_t *const messages[], const size_t lengths[], size_t n, uint8_t digests[][DIGEST_BYTES])
+    {
+        std::unique_ptr<uint8_t[][STATE_BYTES]> states(new uint8_t[n][STATE_BYTES]);
+        std::unique_ptr<uint8_t[][LANES][16]> tweakeys(new uint8_t[LANES * n][LANES][16]);
+        std::unique_ptr<uint8_t[][16]> blocks(new uint8_t[LANES * n][16]);
+        std::unique_ptr<uint8_t[][STATE_BYTES]> gathered(new uint8_t[n][STATE_BYTES]);
+        std::unique_ptr<size_t[]> active(new size_t[n]);
+        size_t live = n;
+        for (size_t k = 0; k < n; k++)
+        {
+            init_state(states[k]);
+            active[k] = k;
+        }
+        for (size_t b = 0; live > 0; b++)
+        {
+            // Message k has lengths[k] / RATE full blocks and then the padded one
+            size_t offset = b * RATE, kept = 0;
+            for (size_t a = 0; a < live; a++)
+            {
+                size_t k = active[a];
+                if (offset + RATE <= lengths[k])
+                    absorb(states[k], messages[k] + offset, RATE);
+                else
+                    absorb_padded(states[k], messages[k] + offset, lengths[k] - offset);
+                memcpy(gathered[a], states[k], STATE_BYTES);
+            }
+            permute_batch(gathered.get(), live, tweakeys.get(), blocks.get());
+            for (size_t a = 0; a < live; a++)
+            {
+                size_t k = active[a];
+                memcpy(states[k], gathered[a], STATE_BYTES);
+                if (offset + RATE <= lengths[k])
+                    active[kept++] = k;
+            }
+            live = kept;
+        }
+        // Squeezing: every message is at the same point now
+        for (size_t out = 0; out < DIGEST_BYTES; out += SQUEEZE_BYTES)
+        {
+            if (out > 0)
+                permute_batch(states.get(), n, tweakeys.get(), blocks.get());
+            for (size_t k = 0; k < n; k++)
+                memcpy(digests[k] + out, states[k], SQUEEZE_BYTES);
+        }
+    }
+};
+
+typedef SkinnyHash<Skinny128_384> SkinnyTk3Hash;
+typedef SkinnyHash<Skinny128_256> SkinnyTk2Hash;
+
+inline void skinny_tk3_hash(const uint8_t *m, size_t len, uint8_t digest[32])
+{
+    SkinnyTk3Hash::hash(m, len, digest);
+}
+
+inline void skinny_tk2_hash(const uint8_t *m, size_t len, uint8_t digest[32])
+{
+    SkinnyTk2Hash::hash(m, len, digest);
+}
+
+} // namespace skinny
+
+#endif
@@ -0,0 +1,410 @@
+/*
+ * Meet-in-the-middle partial-key recovery on reduced-round Skinny
+ * Date: Oct 17, 2026
+*/
+// For research on reduced-round variants: the state after the first `middle` rounds is
+// computed forward from known plaintexts under every value of a set of guessed round-tweakey
+// cells, and backward from the ciphertexts (rounds - 1 down to middle) under every value of
+// another set. Round tweakey cells are treated as independent: the cells that are not
+// guessed are unknown, and a state cell is known only if it does not depend on an unknown
+// cell, which forward_known() / backward_known() track through the rounds. The cells known
+// from both sides are matched: the fingerprint of a guess is the value of those cells for
+// every plaintext / ciphertext pair, and a forward and a backward guess with equal
+// fingerprints are a candidate. Relations between the guessed cells through the tweakey
+// schedule are not used, candidates can be filtered against them afterwards.
+//
+// Fingerprints are hashed to 64 bits and spread over buckets by their top bits. Each bucket
+// of forward entries becomes an open-addressing table (linear probing, half full) that the
+// backward entries of the same bucket are probed against; buckets are matched in parallel
+// on a WorkStealingPool and every hash match is confirmed on the full fingerprints. If the
+// forward entries do not fit in memory_limit, both sides are written to temporary bucket
+// files instead, with enough buckets (up to MAX_SPILL_BUCKETS) for one table per thread to fit.
+// run() refuses setups it cannot search (a guess of 64 bits or more, cells outside the
+// rounds, no known pair, no cell known from both sides) and reports a bucket file that
+// cannot be created, written or read back, rather than returning fewer candidates: MitmReport::error is NULL only if the search was complete.
+
+#ifndef SKINNY_MITM_H
+#define SKINNY_MITM_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "skinny_dispatch.h"
+#include "work_pool.h"
+
+namespace skinny
+{
+
+// Bit i for state cell i
+typedef uint16_t CellMask;
+
+struct MitmSetup
+{
+    int rounds; // rounds of the attacked variant
+    int middle; // the states after round middle - 1 are matched
+    // Guessed round tweakey cells (round, cell < 8) of each direction
+    std::vector<std::pair<int, int>> forward_guess;
+    std::vector<std::pair<int, int>> backward_guess;
+};
+
+struct MitmCandidate
+{
+    uint64_t forward_guess;
+    uint64_t backward_guess;
+};
+
+struct MitmReport
+{
+    CellMask forward_known, backward_known, matched;
+    int fingerprint_bits;    // matched cells times the cell size times the pairs
+    uint64_t forward_guesses, backward_guesses;
+    double expected_false;   // candidates expected from random matches
+    size_t buckets;
+    bool spilled;            // bucket files on disk
+    bool truncated;          // more than max_candidates candidates
+    const char *error;       // NULL, or why the setup was refused or candidates may be missing
+    std::vector<MitmCandidate> candidates;
+};
+
+namespace mitm
+{
+
+// Skinny MixColumns on one column: which input rows every output row depends on
+inline CellMask mix_columns_known(CellMask known)
+{
+    CellMask out = 0;
+    for (int c = 0; c < 4; c++)
+    {
+        bool s[4];
+        for (int row = 0; row < 4; row++)
+            s[row] = (known >> (4 * row + c)) & 0x1;
+        bool a[4] = {s[0] && s[2] && s[3], s[0], s[1] && s[2], s[0] && s[2]};
+        for (int row = 0; row < 4; row++)
+            out |= static_cast<CellMask>(a[row] << (4 * row + c));
+    }
+    return out;
+}
+
+inline CellMask inv_mix_columns_known(CellMask known)
+{
+    CellMask out = 0;
+    for (int c = 0; c < 4; c++)
+    {
+        bool a[4];
+        for (int row = 0; row < 4; row++)
+            a[row] = (known >> (4 * row + c)) & 0x1;
+        bool s[4] = {a[1], a[1] && a[2] && a[3], a[1] && a[3], a[0] && a[3]};
+        for (int row = 0; row < 4; row++)
+            out |= static_cast<CellMask>(s[row] << (4 * row + c));
+    }
+    return out;
+}
+
+inline CellMask permute_known(CellMask known, const uint8_t perm[16])
+{
+    CellMask out = 0;
+    for (int i = 0; i < 16; i++)
+        out |= static_cast<CellMask>(((known >> perm[i]) & 0x1) << i);
+    return out;
+}
+
+inline CellMask guessed_in_round(const std::vector<std::pair<int, int>> &guess, int round)
+{
+    CellMask mask = 0;
+    for (const std::pair<int, int> &g : guess)
+        if (g.first == round)
+            mask |= static_cast<CellMask>(1 << g.second);
+    return mask;
+}
+
+inline uint64_t mix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    return h ^ (h >> 33);
+}
+
+struct Entry
+{
+    uint64_t hash;
+    uint64_t guess;
+};
+
+// Entries of one bucket, in memory or in an anonymous temporary file
+class Bucket
+{
+public:
+    Bucket() : file_(NULL), failed_(false) {}
+    ~Bucket()
+    {
+        if (file_ != NULL)
+            fclose(file_);
+    }
+
+    bool spill()
+    {
+        file_ = tmpfile();
+        return file_ != NULL;
+    }
+
+    void append(const Entry *entries, size_t count)
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (file_ == NULL)
+            memory_.insert(memory_.end(), entries, entries + count);
+        else if (fwrite(entries, sizeof(Entry), count, file_) != count)
+            failed_ = true;
+    }
+
+    // False if some entries could not be written (a full disk) or read back
+    bool read(std::vector<Entry> &entries)
+    {
+        if (file_ == NULL)
+        {
+            entries = std::move(memory_);
+            return true;
+        }
+        long end;
+        if (failed_ || fflush(file_) != 0 || (end = ftell(file_)) < 0)
+            return false;
+        entries.resize(end / sizeof(Entry));
+        rewind(file_);
+        return fread(entries.data(), sizeof(Entry), entries.size(), file_) == entries.size();
+    }
+
+private:
+    std::mutex lock_;
+    FILE *file_;
+    bool failed_;
+    std::vector<Entry> memory_;
+};
+
+} // namespace mitm
+
+template <class Cipher>
+class Mitm
+{
+public:
+    static constexpr int R = Cipher::ROUNDS;
+    static constexpr uint64_t TASK_GUESSES = 4096;
+    static constexpr size_t MAX_SPILL_BUCKETS = 256; // two files each
+
+    // plaintexts and ciphertexts: known pairs of the attacked rounds
+    Mitm(const MitmSetup &setup, const std::vector<std::vector<uint8_t>> &plaintexts, const std::vector<std::vector<uint8_t>> &ciphertexts)
+        : setup_(setup), kernels_(select_kernels<Cipher>()), pairs_(plaintexts.size()),
+          plaintexts_(new uint8_t[pairs_ + 1][16]), ciphertexts_(new uint8_t[pairs_ + 1][16])
+    {
+        for (size_t j = 0; j < pairs_; j++)
+            for (uint8_t i = 0; i < 16; i++)
+            {
+                plaintexts_[j][i] = plaintexts[j][i] & Cipher::CELL_MASK;
+                ciphertexts_[j][i] = ciphertexts[j][i] & Cipher::CELL_MASK;
+            }
+        matched_ = forward_known() & backward_known();
+    }
+
+    // State cells after round middle - 1 known from the plaintext and the forward guess
+    CellMask forward_known() const
+    {
+        CellMask known = 0xffff;
+        for (int r = 0; r < setup_.middle; r++)
+        {
+            known &= static_cast<CellMask>(0xff00 | mitm::guessed_in_round(setup_.forward_guess, r));
+            known = mitm::mix_columns_known(mitm::permute_known(known, P));
+        }
+        return known;
+    }
+
+    // The same from the ciphertext and the backward guess
+    CellMask backward_known() const
+    {
+        CellMask known = 0xffff;
+        for (int r = setup_.rounds - 1; r >= setup_.middle; r--)
+        {
+            known = mitm::permute_known(mitm::inv_mix_columns_known(known), Pinv);
+            known &= static_cast<CellMask>(0xff00 | mitm::guessed_in_round(setup_.backward_guess, r));
+        }
+        return known;
+    }
+
+    // Round tweakeys of a guess: the guessed cells set, the others zero
+    static void guess_round_tweakeys(const std::vector<std::pair<int, int>> &cells, uint64_t guess, uint8_t rtk[][8])
+    {
+        memset(rtk, 0, R * 8);
+        for (size_t k = 0; k < cells.size(); k++)
+            rtk[cells[k].first][cells[k].second] = static_cast<uint8_t>((guess >> (Cipher::CELL_BITS * k)) & Cipher::CELL_MASK);
+    }
+
+    // Matched cells of every pair, forward or backward
+    void fingerprint(bool forward, uint64_t guess, std::vector<uint8_t> &out) const
+    {
+        uint8_t rtk[R][8];
+        std::unique_ptr<uint8_t[][16]> states(new uint8_t[pairs_ + 1][16]);
+        if (forward)
+        {
+            guess_round_tweakeys(setup_.forward_guess, guess, rtk);
+            kernels_.encrypt_rounds(setup_.middle, plaintexts_.get(), states.get(), pairs_, rtk);
+        }
+        else
+        {
+            guess_round_tweakeys(setup_.backward_guess, guess, rtk);
+            for (size_t j = 0; j < pairs_; j++)
+                Cipher::dec_rounds(setup_.middle, setup_.rounds, states[j], ciphertexts_[j], rtk);
+        }
+        out.clear();
+        for (size_t j = 0; j < pairs_; j++)
+            for (uint8_t i = 0; i < 16; i++)
+                if ((matched_ >> i) & 0x1)
+                    out.push_back(states[j][i]);
+    }
+
+    // NULL if run() can search this setup: 0 < rounds <= R, 0 <= middle <= rounds, guessed
+    // cells in rounds [0, rounds) and cells [0, 8), fewer than 64 bits guessed on each side
+    // (the guesses are numbered in a uint64_t, UINT64_MAX marks free table slots), at least
+    // one pair and one matched cell (otherwise every pair of guesses would be a candidate)
+    const char *setup_error() const
+    {
+        if (setup_.rounds <= 0 || setup_.rounds > R || setup_.middle < 0 || setup_.middle > setup_.rounds)
+            return "rounds or middle out of range";
+        for (const std::vector<std::pair<int, int>> *guess : {&setup_.forward_guess, &setup_.backward_guess})
+        {
+            if (guess->size() * Cipher::CELL_BITS >= 64)
+                return "64 or more guessed bits on one side";
+            for (const std::pair<int, int> &g : *guess)
+                if (g.first < 0 || g.first >= setup_.rounds || g.second < 0 || g.second >= 8)
+                    return "guessed cell outside the rounds or the round tweakey";
+        }
+        if (pairs_ == 0)
+            return "no known pairs";
+        if (matched_ == 0)
+            return "no cell is known from both sides";
+        return NULL;
+    }
+
+    MitmReport run(WorkStealingPool &pool, size_t memory_limit = size_t(1) << 30, size_t max_candidates = 1 << 20) const
+    {
+        MitmReport report;
+        report.forward_known = forward_known();
+        report.backward_known = backward_known();
+        report.matched = matched_;
+        report.fingerprint_bits = __builtin_popcount(matched_) * Cipher::CELL_BITS * static_cast<int>(pairs_);
+        report.truncated = false;
+        report.buckets = 0;
+        report.spilled = false;
+        report.error = setup_error();
+        if (report.error != NULL)
+        {
+            report.forward_guesses = report.backward_guesses = 0;
+            report.expected_false = 0;
+            return report;
+        }
+        report.forward_guesses = uint64_t(1) << (Cipher::CELL_BITS * setup_.forward_guess.size());
+        report.backward_guesses = uint64_t(1) << (Cipher::CELL_BITS * setup_.backward_guess.size());
+        report.expected_false = static_cast<double>(report.forward_guesses) * report.backward_guesses / pow(2.0, report.fingerprint_bits);
+        // A table of 2 slots per entry for each thread has to fit
+        const size_t table_bytes = 2 * sizeof(mitm::Entry) * report.forward_guesses;
+        size_t buckets = 64;
+        report.spilled = table_bytes > memory_limit;
+        while (report.spilled && buckets < MAX_SPILL_BUCKETS && table_bytes / buckets * pool.threads() > memory_limit)
+            buckets *= 2;
+        report.buckets = buckets;
+        std::vector<mitm::Bucket> forward(buckets), backward(buckets);
+        for (size_t b = 0; b < buckets && report.spilled; b++)
+            if (!forward[b].spill() || !backward[b].spill())
+            {
+                report.error = "cannot create a bucket file";
+                return report;
+            }
+        const int shift = 64 - __builtin_ctzll(buckets);
+        fill(pool, true, report.forward_guesses, forward, shift);
+        fill(pool, false, report.backward_guesses, backward, shift);
+
+        std::mutex lock;
+        pool.run(buckets, [&](size_t b) {
+            std::vector<mitm::Entry> f, g;
+            if (!forward[b].read(f) || !backward[b].read(g))
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                report.error = "cannot write or read back a bucket file";
+                return;
+            }
+            size_t capacity = 2;
+            while (capacity < 2 * f.size())
+                capacity *= 2;
+            std::vector<mitm::Entry> table(capacity, mitm::Entry{0, UINT64_MAX});
+            for (const mitm::Entry &e : f)
+            {
+                size_t slot = e.hash & (capacity - 1);
+                while (table[slot].guess != UINT64_MAX)
+                    slot = (slot + 1) & (capacity - 1);
+                table[slot] = e;
+            }
+            std::vector<MitmCandidate> found;
+            std::vector<uint8_t> fa, fb;
+            for (const mitm::Entry &e : g)
+                for (size_t slot = e.hash & (capacity - 1); table[slot].guess != UINT64_MAX; slot = (slot + 1) & (capacity - 1))
+                    if (table[slot].hash == e.hash)
+                    {
+                        fingerprint(true, table[slot].guess, fa);
+                        fingerprint(false, e.guess, fb);
+                        if (fa == fb)
+                            found.push_back(MitmCandidate{table[slot].guess, e.guess});
+                    }
+            std::lock_guard<std::mutex> guard(lock);
+            for (const MitmCandidate &c : found)
+            {
+                if (report.candidates.size() >= max_candidates)
+                {
+                    report.truncated = true;
+                    break;
+                }
+                report.candidates.push_back(c);
+            }
+        });
+        std::sort(report.candidates.begin(), report.candidates.end(), [](const MitmCandidate &a, const MitmCandidate &b) {
+            return a.forward_guess != b.forward_guess ? a.forward_guess < b.forward_guess : a.backward_guess < b.backward_guess;
+        });
+        return report;
+    }
+
+private:
+    // Fingerprints of every guess of one direction, hashed and sorted into the buckets
+    void fill(WorkStealingPool &pool, bool forward, uint64_t guesses, std::vector<mitm::Bucket> &buckets, int shift) const
+    {
+        pool.run((guesses + TASK_GUESSES - 1) / TASK_GUESSES, [&](size_t task) {
+            std::vector<std::vector<mitm::Entry>> local(buckets.size());
+            std::vector<uint8_t> print;
+            const uint64_t first = task * TASK_GUESSES, last = std::min(guesses, first + TASK_GUESSES);
+            for (uint64_t guess = first; guess < last; guess++)
+            {
+                fingerprint(forward, guess, print);
+                uint64_t h = 0;
+                for (uint8_t cell : print)
+                    h = mitm::mix64(h ^ cell);
+                local[shift == 64 ? 0 : (h >> shift)].push_back(mitm::Entry{h, guess});
+            }
+            for (size_t b = 0; b < buckets.size(); b++)
+                if (!local[b].empty())
+                    buckets[b].append(local[b].data(), local[b].size());
+        });
+    }
+
+    MitmSetup setup_;
+    const Kernels &kernels_;
+    size_t pairs_;
+    std::unique_ptr<uint8_t[][16]> plaintexts_, ciphertexts_;
+    CellMask matched_;
+};
+
+} // namespace skinny
+
+#endif
@@ -0,0 +1,210 @@
+/*
+ * SkinnyPmac: a parallel PMAC-style MAC with the block index as tweak
+ * Date: Oct 18, 2026
+*/
+// A MAC on Skinny-128-256 or Skinny-128-384 in the manner of PMAC with a tweakable block
+// cipher: the key fills the lanes after TK1 (16 or 32 bytes), and block i is encrypted
+// under TK1 = d || 0^56 || i, the domain d in cell 0 and the 64-bit block index in cells
+// 8..15, cell 15 least significant. Domains:
+//   0 message block other than the last, 1 / 2 tag after a full / partial last block.
+// sigma = XOR of E(i, 0)(M_i) over all blocks but the last
+// tag = E(n, 1)(sigma ^ M_n) for a full last block M_n (n blocks before it), otherwise
+// E(n, 2)(sigma ^ (M_n || 10*)); the empty message has one empty partial block.
+// As in SkinnyAead, the blocks are cut into chunks of CHUNK_BLOCKS that run the per-block
+// TK1 batch kernels of select_kernels(), optionally on a WorkStealingPool, and every
+// chunk leaves a partial sigma; the partial sums are XORed together at the end.
+// update() appends data: it keeps back the last (possibly full) block until more data
+// follows, so a message can be authenticated in pieces of any size, every large piece
+// going through the chunks in parallel.
+
+#ifndef SKINNY_PMAC_H
+#define SKINNY_PMAC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include "skinny_dispatch.h"
+#include "work_pool.h"
+
+namespace skinny
+{
+
+template <class SkinnyCipher>
+class SkinnyPmac
+{
+    static_assert(SkinnyCipher::BLOCK_BITS == 128 && SkinnyCipher::LANES > 1, "SkinnyPmac runs on Skinny-128-256 or Skinny-128-384");
+
+public:
+    typedef SkinnyCipher Cipher;
+    static constexpr int R = Cipher::ROUNDS;
+    static constexpr int LANES = Cipher::LANES;
+    static constexpr size_t KEY_BYTES = 16 * (LANES - 1);
+    static const int TAG_BYTES = 16;
+    static constexpr size_t CHUNK_BLOCKS = 2048;
+
+    SkinnyPmac(const uint8_t key[KEY_BYTES]) : kernels_(select_kernels<Cipher>())
+    {
+        uint8_t tk[LANES][16];
+        memset(tk[0], 0, 16);
+        memcpy(tk[1], key, KEY_BYTES);
+        kernels_.tweakey_schedule(tk, rtk_);
+        reset();
+    }
+
+    void reset()
+    {
+        memset(sigma_, 0, 16);
+        blocks_ = 0;
+        buf_len_ = 0;
+    }
+
+    void update(const uint8_t *data, size_t len, WorkStealingPool &pool)
+    {
+        append(data, len, &pool);
+    }
+
+    void update(const uint8_t *data, size_t len)
+    {
+        append(data, len, NULL);
+    }
+
+    // Writes the tag of everything appended since the last reset() and resets
+    void final(uint8_t tag[16])
+    {
+        finish(sigma_, blocks_, buf_, buf_len_, tag);
+        reset();
+    }
+
+    void mac(const uint8_t *m, size_t len, uint8_t tag[16], WorkStealingPool &pool) const
+    {
+        mac_message(m, len, tag, &pool);
+    }
+
+    void mac(const uint8_t *m, size_t len, uint8_t tag[16]) const
+    {
+        mac_message(m, len, tag, NULL);
+    }
+
+    // Compares in constant time
+    bool verify(const uint8_t *m, size_t len, const uint8_t tag[16], WorkStealingPool &pool) const
+    {
+        return verify_message(m, len, tag, &pool);
+    }
+
+    bool verify(const uint8_t *m, size_t len, const uint8_t tag[16]) const
+    {
+        return verify_message(m, len, tag, NULL);
+    }
+
+    static void compose_tk1(uint64_t index, uint8_t domain, uint8_t tk1[16])
+    {
+        tk1[0] = domain;
+        memset(tk1 + 1, 0, 7);
+        for (int k = 15; k >= 8; k--, index >>= 8)
+            tk1[k] = static_cast<uint8_t>(index);
+    }
+
+private:
+    void tbc(uint8_t block[1][16], uint64_t index, uint8_t domain) const
+    {
+        uint8_t tk1[1][16];
+        compose_tk1(index, domain, tk1[0]);
+        kernels_.encrypt_tk1(block, block, tk1, 1, rtk_);
+    }
+
+    // XORs E(first + j, 0)(in_j) for j < blocks into sigma, by chunks
+    void bulk(const uint8_t *in, size_t blocks, uint64_t first, uint8_t sigma[16], WorkStealingPool *pool) const
+    {
+        const size_t tasks = (blocks + CHUNK_BLOCKS - 1) / CHUNK_BLOCKS;
+        if (tasks == 0)
+            return;
+        std::unique_ptr<uint8_t[]> partial(new uint8_t[16 * tasks]);
+        auto task = [&](size_t t) {
+            uint8_t tk1[CHUNK_BLOCKS][16], encrypted[CHUNK_BLOCKS][16];
+            uint8_t sum[16] = {0};
+            size_t start = t * CHUNK_BLOCKS;
+            size_t n = std::min(CHUNK_BLOCKS, blocks - start);
+            for (size_t j = 0; j < n; j++)
+                compose_tk1(first + start + j, 0, tk1[j]);
+            kernels_.encrypt_tk1(reinterpret_cast<const uint8_t(*)[16]>(in + 16 * start), encrypted, tk1, n, rtk_);
+            for (size_t j = 0; j < n; j++)
+                for (uint8_t i = 0; i < 16; i++)
+                    sum[i] ^= encrypted[j][i];
+            memcpy(&partial[16 * t], sum, 16);
+        };
+        if (pool != NULL && tasks > 1)
+            pool->run(tasks, task);
+        else
+            for (size_t t = 0; t < tasks; t++)
+                task(t);
+        for (size_t t = 0; t < tasks; t++)
+            for (uint8_t i = 0; i < 16; i++)
+                sigma[i] ^= partial[16 * t + i];
+    }
+
+    // The last block, len <= 16 bytes, after index blocks
+    void finish(const uint8_t sigma[16], uint64_t index, const uint8_t *last, size_t len, uint8_t tag[16]) const
+    {
+        uint8_t block[1][16];
+        memcpy(block[0], sigma, 16);
+        for (size_t i = 0; i < len; i++)
+            block[0][i] ^= last[i];
+        if (len < 16)
+            block[0][len] ^= 0x80;
+        tbc(block, index, (len == 16) ? 1 : 2);
+        memcpy(tag, block[0], 16);
+    }
+
+    void append(const uint8_t *data, size_t len, WorkStealingPool *pool)
+    {
+        if (len == 0)
+            return;
+        size_t take = std::min(16 - buf_len_, len);
+        memcpy(buf_ + buf_len_, data, take);
+        buf_len_ += take;
+        data += take;
+        len -= take;
+        if (len == 0)
+            return;
+        // More data follows, so the buffered block is not the last one
+        bulk(buf_, 1, blocks_++, sigma_, NULL);
+        size_t full = (len - 1) / 16;
+        bulk(data, full, blocks_, sigma_, pool);
+        blocks_ += full;
+        buf_len_ = len - 16 * full;
+        memcpy(buf_, data + 16 * full, buf_len_);
+    }
+
+    void mac_message(const uint8_t *m, size_t len, uint8_t tag[16], WorkStealingPool *pool) const
+    {
+        uint8_t sigma[16] = {0};
+        size_t full = (len > 0) ? (len - 1) / 16 : 0;
+        bulk(m, full, 0, sigma, pool);
+        finish(sigma, full, m + 16 * full, len - 16 * full, tag);
+    }
+
+    bool verify_message(const uint8_t *m, size_t len, const uint8_t tag[16], WorkStealingPool *pool) const
+    {
+        uint8_t expected[16], diff = 0;
+        mac_message(m, len, expected, pool);
+        for (uint8_t i = 0; i < 16; i++)
+            diff |= expected[i] ^ tag[i];
+        return diff == 0;
+    }
+
+    const Kernels &kernels_;
+    uint8_t rtk_[R][8];
+    uint8_t sigma_[16];
+    uint64_t blocks_;
+    uint8_t buf_[16];
+    size_t buf_len_;
+};
+
+typedef SkinnyPmac<Skinny128_256> SkinnyPmac256;
+typedef SkinnyPmac<Skinny128_384> SkinnyPmac384;
+
+} // namespace skinny
+
+#endif
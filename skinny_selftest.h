@@ -0,0 +1,532 @@
+/*
+ * Self-tests of the Skinny variants
+ * Date: Oct 18, 2026
+*/
+// self_test<Cipher>() checks a test vector and then every implementation of the variant
+// against the reference enc()/dec(): the row-as-word path, the variant's own kernels
+// (bitsliced, byte-sliced and packed for Skinny-64; fixsliced, bitsliced AVX2 and T-table
+// for Skinny-128), the dispatched batch kernels, traces, the on-the-fly tweakey schedule,
+// multi-key batches, CTR mode, the tweakey cache and the tweak context. Every check
+// prints one line; the result is false if any of them failed. The four cipher demos
+// (make check) are thin wrappers around it.
+
+#ifndef SKINNY_SELFTEST_H
+#define SKINNY_SELFTEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "skinny_ctr.h"
+#include "tweakey_cache.h"
+
+namespace skinny
+{
+
+template <class Cipher>
+void print_cells(const uint8_t state[16])
+{
+    for (int i = 0; i < 16; i++)
+        printf((Cipher::CELL_BITS == 4) ? "%01x" : "%02x", state[i]);
+    printf("\n");
+}
+
+inline bool report(const char *name, bool passed)
+{
+    printf("%-30s%s\n", name, passed ? "passed" : "failed");
+    return passed;
+}
+
+// Bitsliced (64 blocks), byte-sliced SSSE3/AVX2 and packed Skinny-64 kernels against enc() and dec()
+template <class Cipher>
+bool self_test_kernels64(const uint8_t plaintext[16], const uint8_t rtk[][8])
+{
+    using namespace kernels64;
+    const int R = Cipher::ROUNDS;
+    uint8_t bs_plaintext[64][16];
+    uint8_t bs_ciphertext[64][16];
+    uint8_t bs_decrypted[64][16];
+    uint8_t block[16];
+    bool passed = true, bs_passed = true;
+    for (int j = 0; j < 64; j++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            bs_plaintext[j][i] = plaintext[i];
+        bs_plaintext[j][14] ^= (j >> 4) & 0xf;
+        bs_plaintext[j][15] ^= j & 0xf;
+    }
+    enc_bitsliced(R, bs_plaintext, bs_ciphertext, rtk);
+    dec_bitsliced(R, bs_decrypted, bs_ciphertext, rtk);
+    for (int j = 0; j < 64; j++)
+    {
+        Cipher::enc(R, bs_plaintext[j], block, rtk);
+        for (uint8_t i = 0; i < 16; i++)
+            if (block[i] != bs_ciphertext[j][i] || bs_plaintext[j][i] != bs_decrypted[j][i])
+                bs_passed = false;
+    }
+    passed &= report("bitsliced (64 blocks):", bs_passed);
+#if defined(__x86_64__) || defined(__i386__)
+    // Byte-sliced SSSE3 (16 blocks) and AVX2 (32 blocks) kernels
+    for (int w = 0; w < 2; w++)
+    {
+        int blocks = (w == 0) ? 16 : 32;
+        bool vs_passed = true;
+        if ((w == 0 && !__builtin_cpu_supports("ssse3")) || (w == 1 && !__builtin_cpu_supports("avx2")))
+            continue;
+        if (w == 0)
+        {
+            enc_ssse3(R, bs_plaintext, bs_ciphertext, rtk);
+            dec_ssse3(R, bs_decrypted, bs_ciphertext, rtk);
+        }
+        else
+        {
+            enc_avx2(R, bs_plaintext, bs_ciphertext, rtk);
+            dec_avx2(R, bs_decrypted, bs_ciphertext, rtk);
+        }
+        for (int j = 0; j < blocks; j++)
+        {
+            Cipher::enc(R, bs_plaintext[j], block, rtk);
+            for (uint8_t i = 0; i < 16; i++)
+                if (block[i] != bs_ciphertext[j][i] || bs_plaintext[j][i] != bs_decrypted[j][i])
+                    vs_passed = false;
+        }
+        passed &= report((w == 0) ? "ssse3 (16 blocks):" : "avx2 (32 blocks):", vs_passed);
+    }
+#endif
+    // Single-block packed state
+    uint64_t rtk_packed[R];
+    tweakey_schedule_packed(R, rtk, rtk_packed);
+    uint64_t packed_ciphertext = enc_packed(R, pack_state(plaintext), rtk_packed);
+    Cipher::enc(R, plaintext, block, rtk);
+    printf("%-30s%016llx\n", "packed ciphertext:", (unsigned long long)packed_ciphertext);
+    passed &= report("packed (uint64_t state):",
+                     packed_ciphertext == pack_state(block) && dec_packed(R, packed_ciphertext, rtk_packed) == pack_state(plaintext));
+    return passed;
+}
+
+// Fixsliced (32/64-bit words), bitsliced AVX2 (256 blocks) and T-table Skinny-128 kernels against enc() and dec()
+template <class Cipher>
+bool self_test_kernels128(const uint8_t plaintext[16], const uint8_t rtk[][8])
+{
+    using namespace kernels128;
+    const int R = Cipher::ROUNDS;
+    uint32_t rtk32[R][8];
+    uint64_t rtk64[R][8];
+    uint8_t fs_plaintext[4][16];
+    uint8_t fs_ciphertext[4][16];
+    uint8_t fs_decrypted[4][16];
+    uint8_t block[16];
+    bool passed = true, fs_passed = true;
+    for (int j = 0; j < 4; j++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            fs_plaintext[j][i] = plaintext[i];
+        fs_plaintext[j][15] ^= static_cast<uint8_t>(j);
+    }
+    tweakey_schedule_fixsliced(R, rtk, rtk32);
+    tweakey_schedule_fixsliced(R, rtk, rtk64);
+    for (int w = 0; w < 2; w++)
+    {
+        int blocks = (w == 0) ? 2 : 4;
+        if (w == 0)
+        {
+            enc_fixsliced(R, fs_plaintext, fs_ciphertext, rtk32);
+            dec_fixsliced(R, fs_decrypted, fs_ciphertext, rtk32);
+        }
+        else
+        {
+            enc_fixsliced(R, fs_plaintext, fs_ciphertext, rtk64);
+            dec_fixsliced(R, fs_decrypted, fs_ciphertext, rtk64);
+        }
+        for (int j = 0; j < blocks; j++)
+        {
+            Cipher::enc(R, fs_plaintext[j], block, rtk);
+            for (uint8_t i = 0; i < 16; i++)
+                if (block[i] != fs_ciphertext[j][i] || fs_plaintext[j][i] != fs_decrypted[j][i])
+                    fs_passed = false;
+        }
+    }
+    passed &= report("fixsliced (32/64-bit words):", fs_passed);
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx2"))
+    {
+        uint8_t bs_plaintext[256][16];
+        uint8_t bs_ciphertext[256][16];
+        uint8_t bs_decrypted[256][16];
+        bool bs_passed = true;
+        for (int j = 0; j < 256; j++)
+        {
+            for (uint8_t i = 0; i < 16; i++)
+                bs_plaintext[j][i] = plaintext[i];
+            bs_plaintext[j][15] ^= static_cast<uint8_t>(j);
+        }
+        enc_bitsliced_avx2(R, bs_plaintext, bs_ciphertext, rtk);
+        dec_bitsliced_avx2(R, bs_decrypted, bs_ciphertext, rtk);
+        for (int j = 0; j < 256; j++)
+        {
+            Cipher::enc(R, bs_plaintext[j], block, rtk);
+            for (uint8_t i = 0; i < 16; i++)
+                if (block[i] != bs_ciphertext[j][i] || bs_plaintext[j][i] != bs_decrypted[j][i])
+                    bs_passed = false;
+        }
+        passed &= report("avx2 bitsliced (256 blocks):", bs_passed);
+    }
+#endif
+    uint32_t rk_ttable[R][4];
+    uint32_t rk_ttable_inv[R][4];
+    uint8_t tt_ciphertext[16];
+    uint8_t tt_decrypted[16];
+    tweakey_schedule_ttable(R, rtk, rk_ttable);
+    tweakey_schedule_ttable_inv(R, rtk, rk_ttable_inv);
+    enc_ttable(R, plaintext, tt_ciphertext, rk_ttable);
+    dec_ttable(R, tt_decrypted, tt_ciphertext, rk_ttable_inv);
+    Cipher::enc(R, plaintext, block, rtk);
+    passed &= report("t-table:", memcmp(block, tt_ciphertext, 16) == 0 && memcmp(plaintext, tt_decrypted, 16) == 0);
+    return passed;
+}
+
+// tweakey holds the LANES lanes of the test vector, expected its ciphertext
+template <class Cipher>
+bool self_test(const uint8_t tweakey[][16], const uint8_t plaintext[16], const uint8_t expected[16])
+{
+    const int R = Cipher::ROUNDS;
+    uint8_t rtk[R][8];
+    uint8_t ciphertext[16], decrypted[16], block[16];
+    bool all_passed = true;
+    Cipher::tweakey_schedule(R, tweakey, rtk);
+    typename Cipher::Key key;
+    Cipher::expand_key(tweakey, key);
+    printf("%-30s", "plaintext before encryption:");
+    print_cells<Cipher>(plaintext);
+    Cipher::encrypt(key, plaintext, ciphertext);
+    Cipher::decrypt(key, decrypted, ciphertext);
+#ifdef SKINNY_TTABLE
+    // T-table backend selected at build time (not constant-time)
+    if constexpr (Cipher::BLOCK_BITS == 128)
+    {
+        uint32_t rk_ttable[R][4], rk_ttable_inv[R][4];
+        kernels128::tweakey_schedule_ttable(R, rtk, rk_ttable);
+        kernels128::tweakey_schedule_ttable_inv(R, rtk, rk_ttable_inv);
+        kernels128::enc_ttable(R, plaintext, ciphertext, rk_ttable);
+        kernels128::dec_ttable(R, decrypted, ciphertext, rk_ttable_inv);
+    }
+#endif
+    printf("%-30s", "ciphertext:");
+    print_cells<Cipher>(ciphertext);
+    printf("%-30s", "expected ciphertext:");
+    print_cells<Cipher>(expected);
+    printf("%-30s", "plaintext after decryption:");
+    print_cells<Cipher>(decrypted);
+    all_passed &= report("test vector:", memcmp(ciphertext, expected, 16) == 0 && memcmp(decrypted, plaintext, 16) == 0);
+
+    // Row-as-word path (rounds unrolled at compile time) on 16 blocks
+    uint8_t rows_plaintext[16];
+    uint8_t rows_ciphertext[16];
+    uint8_t rows_expected[16];
+    bool rows_passed = true;
+    for (int j = 0; j < 16; j++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            rows_plaintext[i] = static_cast<uint8_t>((plaintext[i] + j * (i + 1)) & Cipher::CELL_MASK);
+        Cipher::encrypt(key, rows_plaintext, rows_ciphertext);
+        Cipher::enc(R, rows_plaintext, rows_expected, rtk);
+        rows_passed &= memcmp(rows_ciphertext, rows_expected, 16) == 0;
+        Cipher::decrypt(key, rows_expected, rows_ciphertext);
+        rows_passed &= memcmp(rows_expected, rows_plaintext, 16) == 0;
+    }
+    all_passed &= report("row-as-word:", rows_passed);
+
+    if constexpr (Cipher::CELL_BITS == 4)
+        all_passed &= self_test_kernels64<Cipher>(plaintext, rtk);
+    else
+        all_passed &= self_test_kernels128<Cipher>(plaintext, rtk);
+
+    // Dispatched batch kernels: every kernel this CPU can run, on a batch that is not a multiple of any chunk size
+    const int batch = 1000;
+    const Kernels &kernels = select_kernels<Cipher>();
+    uint8_t(*batch_plaintext)[16] = new uint8_t[batch][16];
+    uint8_t(*batch_ciphertext)[16] = new uint8_t[batch][16];
+    uint8_t(*batch_decrypted)[16] = new uint8_t[batch][16];
+    uint8_t dispatch_rtk[R][8], base_rtk[R][8], tk1_rtk[R][8];
+    uint8_t tk1_tweakey[Cipher::LANES][16];
+    bool dispatch_passed = true;
+    for (int j = 0; j < batch; j++)
+        for (uint8_t i = 0; i < 16; i++)
+            batch_plaintext[j][i] = static_cast<uint8_t>((plaintext[i] + j * (i + 1)) & Cipher::CELL_MASK);
+    kernels.tweakey_schedule(tweakey, dispatch_rtk);
+    dispatch_passed &= memcmp(dispatch_rtk, rtk, sizeof(rtk)) == 0;
+    // Round tweakeys without TK1, for the per-block TK1 kernels
+    memcpy(tk1_tweakey, tweakey, sizeof(tk1_tweakey));
+    memset(tk1_tweakey[0], 0, 16);
+    Cipher::tweakey_schedule(R, tk1_tweakey, base_rtk);
+    for (int isa = 0; isa < ISA_COUNT; isa++)
+    {
+        const Kernels *k = kernels_for<Cipher>(isa);
+        if (k == NULL || !cpu_supports(isa))
+            continue;
+        k->encrypt(batch_plaintext, batch_ciphertext, batch, dispatch_rtk);
+        k->decrypt(batch_decrypted, batch_ciphertext, batch, dispatch_rtk);
+        for (int j = 0; j < batch; j++)
+        {
+            Cipher::enc(R, batch_plaintext[j], block, rtk);
+            dispatch_passed &= memcmp(block, batch_ciphertext[j], 16) == 0 && memcmp(batch_plaintext[j], batch_decrypted[j], 16) == 0;
+        }
+        // Per-block TK1: block j takes block j + 1 as its TK1
+        k->encrypt_tk1(batch_plaintext, batch_ciphertext, batch_plaintext + 1, batch - 1, base_rtk);
+        k->decrypt_tk1(batch_decrypted, batch_ciphertext, batch_plaintext + 1, batch - 1, base_rtk);
+        for (int j = 0; j < batch - 1; j++)
+        {
+            memcpy(tk1_tweakey[0], batch_plaintext[j + 1], 16);
+            Cipher::tweakey_schedule(R, tk1_tweakey, tk1_rtk);
+            Cipher::enc(R, batch_plaintext[j], block, tk1_rtk);
+            dispatch_passed &= memcmp(block, batch_ciphertext[j], 16) == 0 && memcmp(batch_plaintext[j], batch_decrypted[j], 16) == 0;
+        }
+        // Reduced rounds: the first r rounds of the schedule, for every r
+        for (int r = 1; r < R; r++)
+        {
+            k->encrypt_rounds(r, batch_plaintext, batch_ciphertext, batch, dispatch_rtk);
+            for (int j = 0; j < batch; j++)
+            {
+                Cipher::enc(r, batch_plaintext[j], block, rtk);
+                dispatch_passed &= memcmp(block, batch_ciphertext[j], 16) == 0;
+            }
+        }
+    }
+    printf("%-30s%s (%s)\n", "dispatch:", dispatch_passed ? "passed" : "failed", kernels.name);
+    all_passed &= dispatch_passed;
+    delete[] batch_plaintext;
+    delete[] batch_ciphertext;
+    delete[] batch_decrypted;
+
+    // Traces: every step of enc() against its definition, dec() undoing them in reverse,
+    // encrypt() and the traced batch kernels against enc() block by block
+    const int steps = TRACE_STEPS * R;
+    const size_t trace_batch = 1000;
+    uint8_t(*trace_plaintext)[16] = new uint8_t[trace_batch][16];
+    uint8_t(*trace_ciphertext)[16] = new uint8_t[trace_batch][16];
+    uint8_t(*trace_states)[16] = new uint8_t[steps * trace_batch][16];
+    uint8_t(*trace_inverse)[16] = new uint8_t[steps * trace_batch][16];
+    uint8_t traced[steps][16], inverse_traced[steps][16], unrolled_traced[steps][16], expected_state[16];
+    bool trace_passed = true;
+    Cipher::enc(R, plaintext, block, rtk, StateTrace{traced, 1});
+    Cipher::dec(R, expected_state, block, rtk, StateTrace{inverse_traced, 1});
+    for (int r = 0; r < R; r++)
+    {
+        const uint8_t *before = (r == 0) ? plaintext : traced[TRACE_STEPS * r - 1];
+        const uint8_t *sbox = (Cipher::CELL_BITS == 4) ? S4 : S8;
+        uint8_t *s = traced[TRACE_STEPS * r];
+        for (uint8_t i = 0; i < 16; i++)
+            expected_state[i] = sbox[before[i]];
+        trace_passed &= memcmp(expected_state, s + 16 * TRACE_SUB_CELLS, 16) == 0;
+        add_constants_cells(r, expected_state);
+        trace_passed &= memcmp(expected_state, s + 16 * TRACE_ADD_CONSTANTS, 16) == 0;
+        for (uint8_t i = 0; i < 8; i++)
+            expected_state[i] ^= rtk[r][i];
+        trace_passed &= memcmp(expected_state, s + 16 * TRACE_ADD_ROUND_TWEAKEY, 16) == 0;
+        for (uint8_t i = 0; i < 16; i++)
+            expected_state[i] = s[16 * TRACE_ADD_ROUND_TWEAKEY + P[i]];
+        trace_passed &= memcmp(expected_state, s + 16 * TRACE_SHIFT_ROWS, 16) == 0;
+        mix_columns(expected_state);
+        trace_passed &= memcmp(expected_state, s + 16 * TRACE_MIX_COLUMNS, 16) == 0;
+        // Undoing a step gives the state before it
+        for (int step = 0; step < TRACE_STEPS; step++)
+            trace_passed &= memcmp(inverse_traced[TRACE_STEPS * r + step], (step == 0) ? before : s + 16 * (step - 1), 16) == 0;
+    }
+    trace_passed &= memcmp(traced[steps - 1], block, 16) == 0;
+    Cipher::encrypt(key, plaintext, block, StateTrace{unrolled_traced, 1});
+    trace_passed &= memcmp(unrolled_traced, traced, sizeof(traced)) == 0;
+    for (size_t j = 0; j < trace_batch; j++)
+        for (uint8_t i = 0; i < 16; i++)
+            trace_plaintext[j][i] = static_cast<uint8_t>((plaintext[i] + j * (i + 3)) & Cipher::CELL_MASK);
+    encrypt_traced<Cipher>(R, trace_plaintext, trace_ciphertext, trace_batch, rtk, StateTrace{trace_states, trace_batch});
+    decrypt_traced<Cipher>(R, trace_plaintext, trace_ciphertext, trace_batch, rtk, StateTrace{trace_inverse, trace_batch});
+    for (size_t j = 0; j < trace_batch; j++)
+    {
+        Cipher::enc(R, trace_plaintext[j], block, rtk, StateTrace{traced, 1});
+        Cipher::dec(R, expected_state, block, rtk, StateTrace{inverse_traced, 1});
+        for (int k = 0; k < steps; k++)
+            trace_passed &= memcmp(trace_states[k * trace_batch + j], traced[k], 16) == 0 &&
+                            memcmp(trace_inverse[k * trace_batch + j], inverse_traced[k], 16) == 0;
+    }
+    all_passed &= report("trace:", trace_passed);
+    delete[] trace_plaintext;
+    delete[] trace_ciphertext;
+    delete[] trace_states;
+    delete[] trace_inverse;
+
+    // On-the-fly tweakey schedule: every round tweakey and a step back from the next state,
+    // then enc_otf()/dec_otf() and the unrolled encrypt_otf()/decrypt_otf() against enc()
+    typename Cipher::TweakeyState otf_first, otf_last, otf_state;
+    typename Cipher::row_t otf_rtk[2];
+    uint8_t otf_ciphertext[16], otf_decrypted[16];
+    bool otf_passed = true;
+    Cipher::load_tweakey(tweakey, otf_first);
+    Cipher::load_tweakey(tweakey, otf_last, R - 1);
+    otf_state = otf_first;
+    for (int r = 0; r < R; r++)
+    {
+        typename Cipher::TweakeyState step_back;
+        Cipher::round_tweakey_rows(otf_state, otf_rtk);
+        for (uint8_t i = 0; i < 8; i++)
+            otf_passed &= ((otf_rtk[i >> 2] >> (Cipher::CELL_BITS * (i & 0x3))) & Cipher::CELL_MASK) == rtk[r][i];
+        if (r < R - 1)
+        {
+            Cipher::next_tweakey(otf_state);
+            step_back = otf_state;
+            Cipher::prev_tweakey(step_back);
+            Cipher::round_tweakey_rows(step_back, otf_rtk);
+            for (uint8_t i = 0; i < 8; i++)
+                otf_passed &= ((otf_rtk[i >> 2] >> (Cipher::CELL_BITS * (i & 0x3))) & Cipher::CELL_MASK) == rtk[r][i];
+        }
+    }
+    otf_passed &= memcmp(&otf_state, &otf_last, sizeof(otf_state)) == 0;
+    for (int j = 0; j < 16; j++)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            block[i] = static_cast<uint8_t>((plaintext[i] + j * (i + 5)) & Cipher::CELL_MASK);
+        Cipher::enc(R, block, otf_ciphertext, rtk);
+        Cipher::enc_otf(R, block, otf_decrypted, otf_first);
+        otf_passed &= memcmp(otf_ciphertext, otf_decrypted, 16) == 0;
+        Cipher::encrypt_otf(otf_first, block, otf_decrypted);
+        otf_passed &= memcmp(otf_ciphertext, otf_decrypted, 16) == 0;
+        Cipher::dec_otf(R, otf_decrypted, otf_ciphertext, otf_last);
+        otf_passed &= memcmp(block, otf_decrypted, 16) == 0;
+        memset(otf_decrypted, 0, 16);
+        Cipher::decrypt_otf(otf_last, otf_decrypted, otf_ciphertext);
+        otf_passed &= memcmp(block, otf_decrypted, 16) == 0;
+    }
+    all_passed &= report("on-the-fly tweakey:", otf_passed);
+
+    // Multi-key batch: every block under its own tweakey, checked against tweakey_schedule() and enc()
+    const size_t multikey_batch = 1000;
+    uint8_t(*multikey_tweakey)[Cipher::LANES][16] = new uint8_t[multikey_batch][Cipher::LANES][16];
+    uint8_t(*multikey_plaintext)[16] = new uint8_t[multikey_batch][16];
+    uint8_t(*multikey_ciphertext)[16] = new uint8_t[multikey_batch][16];
+    uint8_t(*multikey_decrypted)[16] = new uint8_t[multikey_batch][16];
+    uint8_t multikey_rtk[R][8];
+    bool multikey_passed = true;
+    for (size_t j = 0; j < multikey_batch; j++)
+    {
+        for (int l = 0; l < Cipher::LANES; l++)
+            for (uint8_t i = 0; i < 16; i++)
+                multikey_tweakey[j][l][i] = static_cast<uint8_t>((tweakey[l][i] + j * (2 * l + i + 1) + (j >> 4)) & Cipher::CELL_MASK);
+        for (uint8_t i = 0; i < 16; i++)
+            multikey_plaintext[j][i] = static_cast<uint8_t>((plaintext[i] + j * (i + 1)) & Cipher::CELL_MASK);
+    }
+    encrypt_multikey<Cipher>(R, multikey_plaintext, multikey_ciphertext, multikey_batch, multikey_tweakey);
+    decrypt_multikey<Cipher>(R, multikey_decrypted, multikey_ciphertext, multikey_batch, multikey_tweakey);
+    for (size_t j = 0; j < multikey_batch; j++)
+    {
+        Cipher::tweakey_schedule(R, multikey_tweakey[j], multikey_rtk);
+        Cipher::enc(R, multikey_plaintext[j], block, multikey_rtk);
+        multikey_passed &= memcmp(block, multikey_ciphertext[j], 16) == 0 && memcmp(multikey_plaintext[j], multikey_decrypted[j], 16) == 0;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    // The Skinny-128 AVX2 kernels too, when the batch above went through AVX-512
+    if constexpr (Cipher::BLOCK_BITS == 128)
+        if (__builtin_cpu_supports("avx2"))
+        {
+            memset(multikey_decrypted, 0, 256 * 16);
+            kernels128::enc_bitsliced_multikey_avx2<Cipher::LANES>(R, multikey_plaintext, multikey_decrypted, multikey_tweakey);
+            multikey_passed &= memcmp(multikey_decrypted, multikey_ciphertext, 256 * 16) == 0;
+            kernels128::dec_bitsliced_multikey_avx2<Cipher::LANES>(R, multikey_decrypted, multikey_ciphertext, multikey_tweakey);
+            multikey_passed &= memcmp(multikey_decrypted, multikey_plaintext, 256 * 16) == 0;
+        }
+#endif
+    all_passed &= report("multi-key (1000 blocks):", multikey_passed);
+    delete[] multikey_tweakey;
+    delete[] multikey_plaintext;
+    delete[] multikey_ciphertext;
+    delete[] multikey_decrypted;
+
+    // CTR mode on 4 threads (3 chunks and a partial block), counter in the block and in TK1, against enc()
+    WorkStealingPool pool(4);
+    const size_t ctr_bytes = 3 * Ctr<Cipher>::CHUNK_BLOCKS * Ctr<Cipher>::BLOCK_BYTES + 5;
+    const uint64_t first_block = 5;
+    uint8_t *ctr_data = new uint8_t[ctr_bytes];
+    uint8_t counter[16], keystream[16], ctr_rtk[R][8], ctr_tweakey[Cipher::LANES][16];
+    bool ctr_passed = true;
+    for (int mode = 0; mode < 2; mode++)
+    {
+        Ctr<Cipher> ctr(tweakey, plaintext, (mode == 0) ? COUNTER_IN_BLOCK : COUNTER_IN_TK1);
+        for (size_t k = 0; k < ctr_bytes; k++)
+            ctr_data[k] = static_cast<uint8_t>(k * 7);
+        ctr.crypt(ctr_data, ctr_bytes, first_block, pool);
+        for (size_t k = 0; k < ctr_bytes; k++)
+        {
+            size_t b = k / Ctr<Cipher>::BLOCK_BYTES, c = k % Ctr<Cipher>::BLOCK_BYTES;
+            if (c == 0)
+            {
+                memcpy(ctr_tweakey, tweakey, sizeof(ctr_tweakey));
+                if (mode == 0)
+                {
+                    Ctr<Cipher>::add_counter(plaintext, first_block + b, counter);
+                    Cipher::enc(R, counter, keystream, rtk);
+                }
+                else
+                {
+                    memset(counter, 0, 16);
+                    Ctr<Cipher>::add_counter(counter, first_block + b, ctr_tweakey[0]);
+                    Cipher::tweakey_schedule(R, ctr_tweakey, ctr_rtk);
+                    Cipher::enc(R, plaintext, keystream, ctr_rtk);
+                }
+            }
+            uint8_t ks = (Cipher::CELL_BITS == 4) ? static_cast<uint8_t>((keystream[2 * c] << 4) | keystream[2 * c + 1]) : keystream[c];
+            if ((ctr_data[k] ^ ks) != static_cast<uint8_t>(k * 7))
+                ctr_passed = false;
+        }
+        // Decryption is the same operation, here on the calling thread only
+        ctr.crypt(ctr_data, ctr_bytes, first_block);
+        for (size_t k = 0; k < ctr_bytes; k++)
+            if (ctr_data[k] != static_cast<uint8_t>(k * 7))
+                ctr_passed = false;
+    }
+    all_passed &= report("ctr (4 threads):", ctr_passed);
+    delete[] ctr_data;
+
+    // Expanded tweakey cache: the second lookup of the same master tweakey is a hit
+    TweakeyCache cache(R, 16 * Cipher::LANES, 1024, Cipher::expand_master_tweakey);
+    uint8_t master[16 * Cipher::LANES];
+    uint8_t cached_rtk[R][8];
+    bool cache_passed = true;
+    memcpy(master, tweakey, sizeof(master));
+    for (int n = 0; n < 2; n++)
+    {
+        cache.get(master, cached_rtk);
+        cache_passed &= memcmp(cached_rtk, rtk, sizeof(rtk)) == 0;
+    }
+    cache_passed &= cache.hits() == 1;
+    // Master tweakeys the cache cannot hold are refused
+    for (int bad_bytes : {0, 20, 56})
+    {
+        try
+        {
+            TweakeyCache bad(R, bad_bytes, 16, Cipher::expand_master_tweakey);
+            cache_passed = false;
+        }
+        catch (const std::invalid_argument &)
+        {
+        }
+    }
+    printf("%-30s%s (hits: %llu, misses: %llu)\n", "tweakey cache:", cache_passed ? "passed" : "failed",
+           (unsigned long long)cache.hits(), (unsigned long long)cache.misses());
+    all_passed &= cache_passed;
+
+    // Tweak context: fixed key, TK1 changed per block
+    typename Cipher::TweakContext ctx;
+    typename Cipher::Key tweak_key;
+    uint8_t tweak_rtk[R][8];
+    bool tweak_passed = true;
+    Cipher::init_tweak_context(&ctx, tweakey + 1);
+    Cipher::tweak_round_tweakeys(&ctx, tweakey[0], tweak_rtk);
+    Cipher::tweak_key(&ctx, tweakey[0], tweak_key);
+    tweak_passed &= memcmp(tweak_rtk, rtk, sizeof(rtk)) == 0;
+    for (int r = 0; r < R; r++)
+        if (tweak_key.rtk[r][0] != key.rtk[r][0] || tweak_key.rtk[r][1] != key.rtk[r][1])
+            tweak_passed = false;
+    all_passed &= report("tweak context:", tweak_passed);
+    return all_passed;
+}
+
+} // namespace skinny
+
+#endif
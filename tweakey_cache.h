@@ -0,0 +1,191 @@
+/*
+ * Expanded tweakey-schedule cache for the Skinny variants
+ * Date: Oct 17, 2026
+*/
+// Keeps the expanded round tweakeys (rtk[R][8]) of recently used master tweakeys.
+// The cache is split into sets of WAYS slots and evicts the least recently used
+// slot of a set. Lookups never take a lock: each slot carries a sequence counter
+// that is odd while a writer fills it, and a reader that sees the counter change
+// treats the slot as a miss. Inserts lock only their own set. Master tweakeys are
+// compared as 64-bit words: key_bytes must be a multiple of 8 and at most 48 (three
+// lanes), the constructor throws std::invalid_argument otherwise.
+
+#ifndef TWEAKEY_CACHE_H
+#define TWEAKEY_CACHE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+class TweakeyCache
+{
+public:
+    // Expands a master tweakey (TK1 || TK2 || TK3, 16 bytes per lane) into rtk[rounds][8]
+    typedef void (*expand_fn)(const uint8_t *master, uint8_t round_tweakey[][8], int rounds);
+
+    static const int WAYS = 8;
+    static const int MAX_KEY_BYTES = 48;
+
+    TweakeyCache(int rounds, int key_bytes, size_t capacity, expand_fn expand)
+        : rounds_(rounds), key_words_(key_bytes / 8), slot_words_(key_bytes / 8 + rounds), expand_(expand)
+    {
+        if (key_bytes <= 0 || key_bytes > MAX_KEY_BYTES || key_bytes % 8 != 0)
+            throw std::invalid_argument("TweakeyCache: key_bytes must be a multiple of 8 between 8 and 48");
+        sets_ = 1;
+        while (sets_ * WAYS < capacity)
+            sets_ <<= 1;
+        size_t slots = sets_ * WAYS;
+        version_.reset(new std::atomic<uint32_t>[slots]);
+        last_used_.reset(new std::atomic<uint64_t>[slots]);
+        data_.reset(new std::atomic<uint64_t>[slots * slot_words_]);
+        locks_.reset(new std::mutex[sets_]);
+        for (size_t s = 0; s < slots; s++)
+        {
+            version_[s].store(0, std::memory_order_relaxed);
+            last_used_[s].store(0, std::memory_order_relaxed);
+        }
+        for (size_t w = 0; w < slots * slot_words_; w++)
+            data_[w].store(0, std::memory_order_relaxed);
+        clock_.store(1, std::memory_order_relaxed);
+        hits_.store(0, std::memory_order_relaxed);
+        misses_.store(0, std::memory_order_relaxed);
+        evictions_.store(0, std::memory_order_relaxed);
+    }
+
+    // Fills round_tweakey[rounds][8] for the master tweakey. Returns true on a cache hit,
+    // otherwise expands the tweakey and inserts it.
+    bool get(const uint8_t *master, uint8_t round_tweakey[][8])
+    {
+        uint64_t key[MAX_KEY_BYTES / 8];
+        memcpy(key, master, 8 * key_words_);
+        size_t set = hash(key) & (sets_ - 1);
+        if (read(set, key, round_tweakey))
+        {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        expand_(master, round_tweakey, rounds_);
+        insert(set, key, round_tweakey);
+        return false;
+    }
+
+    int rounds() const { return rounds_; }
+    size_t capacity() const { return sets_ * WAYS; }
+    uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+    uint64_t evictions() const { return evictions_.load(std::memory_order_relaxed); }
+
+private:
+    static uint64_t mix(uint64_t x)
+    {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    uint64_t hash(const uint64_t key[]) const
+    {
+        uint64_t h = 0x9e3779b97f4a7c15ULL;
+        for (int w = 0; w < key_words_; w++)
+            h = mix(h ^ key[w]);
+        return h;
+    }
+
+    bool read(size_t set, const uint64_t key[], uint8_t round_tweakey[][8])
+    {
+        uint64_t rtk_word;
+        for (int way = 0; way < WAYS; way++)
+        {
+            size_t slot = set * WAYS + way;
+            const std::atomic<uint64_t> *d = &data_[slot * slot_words_];
+            uint32_t v = version_[slot].load(std::memory_order_acquire);
+            // Empty, or a writer is filling the slot
+            if (v == 0 || (v & 0x1))
+                continue;
+            bool match = true;
+            for (int w = 0; w < key_words_ && match; w++)
+                match = (d[w].load(std::memory_order_relaxed) == key[w]);
+            if (!match)
+                continue;
+            for (int r = 0; r < rounds_; r++)
+            {
+                rtk_word = d[key_words_ + r].load(std::memory_order_relaxed);
+                memcpy(round_tweakey[r], &rtk_word, 8);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version_[slot].load(std::memory_order_relaxed) != v)
+                return false;
+            last_used_[slot].store(clock_.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void insert(size_t set, const uint64_t key[], uint8_t round_tweakey[][8])
+    {
+        uint64_t rtk_word;
+        std::lock_guard<std::mutex> guard(locks_[set]);
+        size_t victim = set * WAYS;
+        uint64_t oldest = UINT64_MAX;
+        for (int way = 0; way < WAYS; way++)
+        {
+            size_t slot = set * WAYS + way;
+            if (version_[slot].load(std::memory_order_relaxed) == 0)
+            {
+                victim = slot;
+                oldest = 0;
+                break;
+            }
+            // Another thread may have inserted the same key meanwhile
+            bool match = true;
+            for (int w = 0; w < key_words_ && match; w++)
+                match = (data_[slot * slot_words_ + w].load(std::memory_order_relaxed) == key[w]);
+            if (match)
+                return;
+            uint64_t used = last_used_[slot].load(std::memory_order_relaxed);
+            if (used < oldest)
+            {
+                oldest = used;
+                victim = slot;
+            }
+        }
+        uint32_t v = version_[victim].load(std::memory_order_relaxed);
+        if (v != 0)
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        version_[victim].store(v + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::atomic<uint64_t> *d = &data_[victim * slot_words_];
+        for (int w = 0; w < key_words_; w++)
+            d[w].store(key[w], std::memory_order_relaxed);
+        for (int r = 0; r < rounds_; r++)
+        {
+            memcpy(&rtk_word, round_tweakey[r], 8);
+            d[key_words_ + r].store(rtk_word, std::memory_order_relaxed);
+        }
+        version_[victim].store(v + 2, std::memory_order_release);
+        last_used_[victim].store(clock_.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    int rounds_;
+    int key_words_;
+    int slot_words_;
+    size_t sets_;
+    expand_fn expand_;
+    std::unique_ptr<std::atomic<uint32_t>[]> version_;
+    std::unique_ptr<std::atomic<uint64_t>[]> last_used_;
+    std::unique_ptr<std::atomic<uint64_t>[]> data_;
+    std::unique_ptr<std::mutex[]> locks_;
+    std::atomic<uint64_t> clock_;
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+    std::atomic<uint64_t> evictions_;
+};
+
+#endif
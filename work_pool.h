@@ -0,0 +1,164 @@
+/*
+ * Reusable work-stealing thread pool
+ * Date: Oct 17, 2026
+*/
+// run(tasks, task) calls task(i) for every i < tasks on the pool threads and the calling
+// thread, and returns when all calls are done. The tasks are dealt round-robin into one
+// deque per thread; a thread takes work from the back of its own deque and, once that is
+// empty, steals from the front of the others, so uneven tasks still balance out. The
+// threads are started once and sleep between runs, a pool is meant to be kept and reused.
+
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool
+{
+public:
+    typedef std::function<void(size_t)> task_fn;
+
+    // threads: total number of threads working on a run, the caller included (0: one per core)
+    explicit WorkStealingPool(unsigned threads = 0)
+    {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+        threads_ = threads;
+        queues_.reset(new Queue[threads_]);
+        for (unsigned id = 1; id < threads_; id++)
+            workers_.emplace_back(&WorkStealingPool::worker, this, id);
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (size_t w = 0; w < workers_.size(); w++)
+            workers_[w].join();
+    }
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    unsigned threads() const { return threads_; }
+
+    // Concurrent runs on the same pool are serialized
+    void run(size_t tasks, const task_fn &task)
+    {
+        if (tasks == 0)
+            return;
+        std::lock_guard<std::mutex> serial(run_lock_);
+        pending_.store(tasks, std::memory_order_relaxed);
+        for (unsigned q = 0; q < threads_; q++)
+        {
+            std::lock_guard<std::mutex> guard(queues_[q].lock);
+            for (size_t i = q; i < tasks; i += threads_)
+                queues_[q].items.push_back(Item{i, &task});
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            generation_++;
+        }
+        wake_.notify_all();
+        drain(0);
+        std::unique_lock<std::mutex> guard(lock_);
+        done_.wait(guard, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    // Each item carries its task, so a thread that wakes late never runs an item of a
+    // newer run with the function of an older one
+    struct Item
+    {
+        size_t index;
+        const task_fn *task;
+    };
+
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<Item> items;
+    };
+
+    bool pop(unsigned self, Item &item)
+    {
+        {
+            std::lock_guard<std::mutex> guard(queues_[self].lock);
+            if (!queues_[self].items.empty())
+            {
+                item = queues_[self].items.back();
+                queues_[self].items.pop_back();
+                return true;
+            }
+        }
+        for (unsigned k = 1; k < threads_; k++)
+        {
+            Queue &victim = queues_[(self + k) % threads_];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.items.empty())
+            {
+                item = victim.items.front();
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void drain(unsigned self)
+    {
+        Item item;
+        while (pop(self, item))
+        {
+            (*item.task)(item.index);
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+                done_.notify_all();
+            }
+        }
+    }
+
+    void worker(unsigned id)
+    {
+        uint64_t seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> guard(lock_);
+                wake_.wait(guard, [this, seen] { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+            }
+            drain(id);
+        }
+    }
+
+    unsigned threads_;
+    std::unique_ptr<Queue[]> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex run_lock_;
+    std::mutex lock_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+    std::atomic<size_t> pending_{0};
+};
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * Seeded pseudorandom generator for the experiments and self-checks
+ * Date: Oct 18, 2026
+*/
+// Not for keys: the experiments and self-checks only need a fast generator whose output
+// for a (seed, stream) is the same on every run and every platform.
+
+#ifndef XOSHIRO256_H
+#define XOSHIRO256_H
+
+#include <stdint.h>
+
+namespace skinny
+{
+
+// xoshiro256** (Blackman and Vigna), the state filled by splitmix64
+class Xoshiro256
+{
+public:
+    Xoshiro256(uint64_t seed, uint64_t stream)
+    {
+        uint64_t x = seed ^ (stream * 0xd1342543de82ef95ULL);
+        for (int i = 0; i < 4; i++)
+            s_[i] = splitmix64(x);
+    }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static uint64_t splitmix64(uint64_t &x)
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t s_[4];
+};
+
+} // namespace skinny
+
+#endif